@@ -1,9 +1,336 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 #include "../graph/graph.h"
 #include "topo.h"
+#include "../graph/csrgraph.h"
 #include "time.h"
 
+/**
+ * @brief Returns the time elapsed since start in seconds
+ */
+double elapsedSeconds(struct timespec start){
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec)/1e9;
+}
+
+/**
+ * @brief Returns 1 if both orderings are equal, 0 otherwise
+ */
+int sameOrdering(int *ordering1, int *ordering2, int n){
+    return memcmp(ordering1, ordering2, sizeof(int)*n) == 0;
+}
+
+/**
+ * @brief Adds degree random edges from each vertex, oriented upwards as in createGraph so that the graph has no cycle
+ */
+static void addRandomUpwardEdges(Graph graph, int degree, RandomGenerator *generator){
+    int n = graph.numberVertices;
+    for (int i = 0; i<n; i++){
+        for (int k = 0; k<degree; k++){
+            int j = rngBounded(generator, n);
+            if (graph.yCoordinates[i] < graph.yCoordinates[j])
+                addEdgeInGraph(graph, i, j);
+            else if (graph.yCoordinates[j] < graph.yCoordinates[i])
+                addEdgeInGraph(graph, j, i);
+        }
+    }
+}
+
+/**
+ * @brief Compares the topological sort of a graph of adjacency lists and of the same graph in CSR format
+ */
+void testCSRTopologicalSort(){
+    printf("---- Test topological sort on a CSR graph ----\n");
+    int n = 1000000;
+    Graph graph = createGraphWithoutEdges(n, 0, rngDefault());
+    addRandomUpwardEdges(graph, 4, rngDefault());
+    CSRGraph csr = createCSRGraphFromGraph(graph, 0);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    topologicalSort(graph);
+    double tList = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    csrTopologicalSort(csr);
+    double tCSR = elapsedSeconds(start);
+    int same = 1;
+    for (int i = 0; i<n; i++){
+        if (graph.topological_ordering[i] != csr.topological_ordering[i])
+            same = 0;
+    }
+    printf("%d vertices, %d edges : lists %.3lf s (%.1lf Medges/s), CSR %.3lf s (%.1lf Medges/s), %s ordering\n",
+           n, csr.numberEdges, tList, csr.numberEdges/tList/1e6, tCSR, csr.numberEdges/tCSR/1e6, same ? "same" : "DIFFERENT");
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test topological sort on a CSR graph ----\n");
+}
+
+/**
+ * @brief Compares the start dates of a graph of adjacency lists and of the same weighted graph in CSR format
+ */
+void testCSRStartDates(){
+    printf("---- Test start dates on a weighted CSR graph ----\n");
+    int n = 2000;
+    RandomGenerator generator;
+    rngSeed(&generator, 21);
+    Graph graph = createGraphWithGenerator(1, n, 0.1, &generator);
+    CSRGraph csr = createCSRGraphFromGraph(graph, 1);
+    topologicalSort(graph);
+    memcpy(csr.topological_ordering, graph.topological_ordering, sizeof(int)*n);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    computeEarliestStartDates(graph);
+    computeLatestStartDates(graph);
+    double tList = elapsedSeconds(start);
+    double *earliestStart = malloc(sizeof(double)*n);
+    double *latestStart = malloc(sizeof(double)*n);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    csrComputeEarliestStartDates(csr, earliestStart);
+    csrComputeLatestStartDates(csr, earliestStart, latestStart);
+    double tCSR = elapsedSeconds(start);
+    /* the dates are the same sums of the same distances, unless the weights are float */
+    double tolerance = sizeof(EdgeWeight) == sizeof(double) ? 0 : 1e-4;
+    int same = 1;
+    for (int i = 0; i<n; i++){
+        if (fabs(graph.earliest_start[i] - earliestStart[i]) > tolerance || fabs(graph.latest_start[i] - latestStart[i]) > tolerance)
+            same = 0;
+    }
+    printf("%d vertices, %d edges : lists %.3lf s, CSR %.6lf s, %s dates\n", n, csr.numberEdges, tList, tCSR,
+           same ? "same" : "DIFFERENT");
+    free(earliestStart);
+    free(latestStart);
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test start dates on a weighted CSR graph ----\n");
+}
+
+/**
+ * @brief Checks the earliest start dates against their definition and measures the time on a large DAG
+ */
+void testLinearStartDates(){
+    printf("---- Test linear start dates ----\n");
+    RandomGenerator generator;
+    rngSeed(&generator, 22);
+    /* definition: the largest date of a predecessor plus the length of the edge, the predecessors being searched in all the lists */
+    int n = 2000;
+    Graph graph = createGraphWithGenerator(1, n, 0.1, &generator);
+    topologicalSort(graph);
+    computeEarliestStartDates(graph);
+    double *reference = malloc(sizeof(double)*n);
+    for (int j = 0; j<n; j++){
+        int vertex = graph.topological_ordering[j];
+        reference[vertex] = 0.00;
+        for (int i = 0; i<n; i++){
+            for (Cell* tmp = graph.array[i]; tmp != NULL; tmp = tmp->nextCell){
+                if (tmp->value == vertex){
+                    double date = reference[i] + distance(graph.xCoordinates[i], graph.yCoordinates[i],
+                                                          graph.xCoordinates[vertex], graph.yCoordinates[vertex]);
+                    if (date > reference[vertex])
+                        reference[vertex] = date;
+                }
+            }
+        }
+    }
+    printf("%d vertices : %s earliest dates as the definition\n", n,
+           memcmp(reference, graph.earliest_start, sizeof(double)*n) == 0 ? "same" : "DIFFERENT");
+    free(reference);
+    freeGraph(graph);
+    /* scheduling DAG of several hundred thousand tasks */
+    n = 500000;
+    graph = createGraphWithGenerator(1, n, sqrt(8/(M_PI*n)), &generator);
+    CSRGraph csr = createCSRGraphFromGraph(graph, 1);
+    topologicalSort(graph);
+    memcpy(csr.topological_ordering, graph.topological_ordering, sizeof(int)*n);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    computeEarliestStartDates(graph);
+    double tEarliest = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    computeLatestStartDates(graph);
+    double tLatest = elapsedSeconds(start);
+    double *earliestStart = malloc(sizeof(double)*n);
+    double *latestStart = malloc(sizeof(double)*n);
+    csrComputeEarliestStartDates(csr, earliestStart);
+    csrComputeLatestStartDates(csr, earliestStart, latestStart);
+    double tolerance = sizeof(EdgeWeight) == sizeof(double) ? 0 : 1e-4;
+    int same = 1;
+    for (int i = 0; i<n; i++){
+        if (fabs(graph.earliest_start[i] - earliestStart[i]) > tolerance || fabs(graph.latest_start[i] - latestStart[i]) > tolerance)
+            same = 0;
+    }
+    printf("%d vertices, %d edges : earliest dates %.1lf ms, latest dates %.1lf ms, %s dates as the CSR graph\n",
+           n, csr.numberEdges, tEarliest*1e3, tLatest*1e3, same ? "same" : "DIFFERENT");
+    free(earliestStart);
+    free(latestStart);
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test linear start dates ----\n");
+}
+
+/**
+ * @brief Checks the levels of the Kahn topological sort and measures it against the depth first search
+ */
+void testLevelTopologicalSort(){
+    printf("---- Test level topological sort ----\n");
+    int nbThreads[3] = {1, 2, 4};
+    RandomGenerator generator;
+    rngSeed(&generator, 24);
+    int n = 1000000;
+    Graph graph = createGraphWithoutEdges(n, 0, &generator);
+    addRandomUpwardEdges(graph, 4, &generator);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    topologicalSort(graph);
+    double tDFS = elapsedSeconds(start);
+    printf("%d vertices : topologicalSort %.3lf s\n", n, tDFS);
+    for (int i = 0; i<n; i++)
+        graph.parents[i] = -7;
+    int *levels = malloc(sizeof(int)*n);
+    int *firstOrdering = malloc(sizeof(int)*n);
+    int *position = malloc(sizeof(int)*n);
+    for (int tracked = 0; tracked < 2; tracked++){
+        if (tracked)
+            trackIncomingEdges(&graph);
+        for (int k = 0; k < 3; k++){
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            int nbLevels = levelTopologicalSort(graph, levels, nbThreads[k]);
+            double t = elapsedSeconds(start);
+            if (tracked == 0 && k == 0)
+                memcpy(firstOrdering, graph.topological_ordering, sizeof(int)*n);
+            /* each vertex once, the levels in the ordering, each level one more than the largest level of the predecessors */
+            int valid = 1;
+            for (int i = 0; i<n; i++)
+                position[i] = -1;
+            for (int p = 0; p<n && valid; p++){
+                int v = graph.topological_ordering[p];
+                valid = v >= 0 && v < n && position[v] == -1 && (p == 0 || levels[graph.topological_ordering[p-1]] <= levels[v]);
+                if (valid)
+                    position[v] = p;
+            }
+            int *largest = position;
+            for (int i = 0; i<n && valid; i++)
+                largest[i] = -1;
+            for (int v = 0; v<n && valid; v++){
+                for (Cell* tmp = graph.array[v]; tmp != NULL; tmp = tmp->nextCell){
+                    if (levels[v] > largest[tmp->value])
+                        largest[tmp->value] = levels[v];
+                }
+            }
+            for (int v = 0; v<n && valid; v++)
+                valid = levels[v] == largest[v] + 1 && levels[v] < nbLevels;
+            int parentsKept = 1;
+            for (int i = 0; i<n; i++)
+                parentsKept = parentsKept && graph.parents[i] == -7;
+            printf("%s, %d threads : %.3lf s, %d levels, %s levels, %s ordering as with 1 thread, parents %s\n",
+                   tracked ? "in-degrees of the index" : "in-degrees counted", nbThreads[k], t, nbLevels,
+                   valid ? "valid" : "DIFFERENT", sameOrdering(firstOrdering, graph.topological_ordering, n) ? "same" : "DIFFERENT",
+                   parentsKept ? "kept" : "DIFFERENT");
+        }
+    }
+    /* a cycle: an edge back to a predecessor of the last vertex */
+    int last = graph.topological_ordering[n-1];
+    addEdgeInGraph(graph, last, graph.incoming->predecessors[last][0]);
+    printf("with a cycle : %s\n", levelTopologicalSort(graph, levels, 2) == -1 ? "rejected" : "DIFFERENT");
+    free(levels);
+    free(firstOrdering);
+    free(position);
+    freeGraph(graph);
+    printf("---- Fin test level topological sort ----\n");
+}
+
+/**
+ * @brief Checks the start dates updated after changes of durations against a full computation and compares their times
+ */
+void testIncrementalStartDates(){
+    printf("---- Test incremental start dates ----\n");
+    RandomGenerator generator;
+    rngSeed(&generator, 25);
+    int n = 1000000;
+    Graph graph = createGraphWithoutEdges(n, 0, &generator);
+    addRandomUpwardEdges(graph, 4, &generator);
+    CSRGraph csr = createCSRGraphFromGraph(graph, 1);
+    freeGraph(graph);
+    csrTopologicalSort(csr);
+    Schedule schedule = createSchedule(csr);
+    double *earliestStart = malloc(sizeof(double)*n);
+    double *latestStart = malloc(sizeof(double)*n);
+    struct timespec start;
+    int nbUpdates = 1000;
+    long recomputed = 0;
+    int fullUpdates = 0;
+    int same = 1;
+    double tIncremental = 0, tFull = 0;
+    int *edges = malloc(sizeof(int)*n);
+    for (int u = 0; u<nbUpdates; u++){
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int count;
+        if (u % 2 == 0){
+            /* duration of an edge multiplied by a factor in [0.5,1.5) */
+            int edge = rngBounded(&generator, csr.numberEdges);
+            count = updateEdgeDuration(&schedule, edge, csr.weights[edge]*(0.5 + rngDouble(&generator)));
+        }
+        else{
+            /* duration of a task: all the out-edges of a vertex */
+            int vertex = rngBounded(&generator, n);
+            double duration = rngDouble(&generator)*0.1;
+            int nbEdges = 0;
+            for (int e = csr.offsets[vertex]; e < csr.offsets[vertex+1]; e++){
+                csr.weights[e] = duration;
+                edges[nbEdges++] = e;
+            }
+            count = updateStartDates(&schedule, edges, nbEdges);
+        }
+        tIncremental += elapsedSeconds(start);
+        recomputed += count;
+        if (count >= n)
+            fullUpdates++;
+        if (u % 100 == 0 || u == nbUpdates-1){
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            csrComputeEarliestStartDates(csr, earliestStart);
+            csrComputeLatestStartDates(csr, earliestStart, latestStart);
+            tFull = elapsedSeconds(start);
+            same = same && memcmp(earliestStart, schedule.earliestStart, sizeof(double)*n) == 0
+                && memcmp(latestStart, schedule.latestStart, sizeof(double)*n) == 0;
+        }
+    }
+    printf("%d vertices, %d edges : full computation %.1lf ms\n", n, csr.numberEdges, tFull*1e3);
+    printf("%d random updates : %.3lf ms per update, %.0lf dates recomputed per update, %d updates of the largest date, %s dates as the full computation\n",
+           nbUpdates, tIncremental/nbUpdates*1e3, (double) recomputed/nbUpdates, fullUpdates, same ? "same" : "DIFFERENT");
+    /* an edge of a critical path to the last well: lengthened then shortened, the largest date changes */
+    int well = 0;
+    for (int v = 0; v<n; v++){
+        if (csr.offsets[v] == csr.offsets[v+1] && schedule.earliestStart[v] == schedule.maxEarliest)
+            well = v;
+    }
+    int critical = -1;
+    for (int e = schedule.predecessors.offsets[well]; e < schedule.predecessors.offsets[well+1]; e++){
+        int edge = schedule.predecessorEdges[e];
+        if (schedule.earliestStart[schedule.predecessors.targets[e]] + csr.weights[edge] == schedule.earliestStart[well])
+            critical = edge;
+    }
+    double maxBefore = schedule.maxEarliest;
+    int criticalFull = 0;
+    EdgeWeight weight = csr.weights[critical];
+    for (int k = 0; k < 2; k++){
+        if (updateEdgeDuration(&schedule, critical, k == 0 ? weight + 0.5 : weight) >= n)
+            criticalFull++;
+        csrComputeEarliestStartDates(csr, earliestStart);
+        csrComputeLatestStartDates(csr, earliestStart, latestStart);
+        same = same && memcmp(earliestStart, schedule.earliestStart, sizeof(double)*n) == 0
+            && memcmp(latestStart, schedule.latestStart, sizeof(double)*n) == 0;
+    }
+    printf("critical edge lengthened and shortened : %d/2 full updates of the latest dates, %s largest date at the end, %s dates as the full computation\n",
+           criticalFull, schedule.maxEarliest == maxBefore ? "same" : "DIFFERENT", same ? "same" : "DIFFERENT");
+    free(edges);
+    free(earliestStart);
+    free(latestStart);
+    freeSchedule(&schedule);
+    freeCSRGraph(&csr);
+    printf("---- Fin test incremental start dates ----\n");
+}
+
 int main() {
     srand(time(NULL));
     // Create a graph
@@ -31,5 +358,11 @@ int main() {
     computeLatestStartDates(graph);
     printConsoleGraph(graph);
     drawGraph(graph, "dates.svg",3,1);
+
+    testCSRTopologicalSort();
+    testCSRStartDates();
+    testLinearStartDates();
+    testLevelTopologicalSort();
+    testIncrementalStartDates();
     return 0;
 }
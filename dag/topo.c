@@ -7,7 +7,14 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include "../graph/graph.h"
+#include "../graph/csrgraph.h"
+#include "../heap/heap.h"
+#include "topo.h"
 #include "../stack/stack.h"
 #define MAX(x,y) (x >= y ? x : y)
 #define MIN(x,y) (x <= y ? x : y)
@@ -82,62 +89,259 @@ void topologicalSort(Graph graph){
 
 
 /**
- * @brief Function to compute the earliest start date of each vertex in a graph.
+ * @brief Function to perform a topological sort of a graph in CSR format. Update the field topological_ordering of the graph.
  *
- * @param graph The graph for which to compute the earliest start dates.
- * Updates the array containing the earliest start date of each vertex in the graph structure.
+ * @param graph The graph to be sorted.
+ *
+ * Same depth first search as topologicalSort, each vertex remembering its next
+ * successor to visit, so that each edge is read once.
  */
+void csrTopologicalSort(CSRGraph graph){
+    int numberOfVertexVisited = 0;
+    int *stack = malloc(sizeof(int)*graph.numberVertices);
+    int *nextEdge = malloc(sizeof(int)*graph.numberVertices);
+    for (int i = 0; i<graph.numberVertices; i++){
+        if (graph.parents[i] != -1){
+            continue;
+        }
+        int top = 0;
+        stack[0] = i;
+        nextEdge[0] = graph.offsets[i];
+        graph.parents[i] = -2;
+        while (top >= 0){
+            int topStack = stack[top];
+            int end = graph.offsets[topStack+1];
+            int e = nextEdge[top];
+            while (e < end && graph.parents[graph.targets[e]] != -1){
+                e++;
+            }
+            if (e < end){
+                int successor = graph.targets[e];
+                nextEdge[top] = e + 1;
+                graph.parents[successor] = -2;
+                top++;
+                stack[top] = successor;
+                nextEdge[top] = graph.offsets[successor];
+            }
+            else {
+                /* the vertex is finished: it comes before all the vertices already finished */
+                graph.parents[topStack] = top == 0 ? topStack : stack[top-1];
+                graph.topological_ordering[graph.numberVertices-1 - numberOfVertexVisited] = topStack;
+                numberOfVertexVisited++;
+                top--;
+            }
+        }
+    }
+    free(stack);
+    free(nextEdge);
+    return;
+}
 
-/*
-   char str[10];
-   int isSource;
-   isSource = 1 ;
-   Stack* stack;
-   double max;
-   for (int j = 0; j<graph.numberVertices; j++){
-   sprintf(str,"%d",j);
 
-   for (int i = 0; i<graph.numberVertices; i++){
+/**
+ * @brief State shared by the threads of levelTopologicalSort
+ */
+typedef struct kahnShared{
+    Graph graph;
+    int *levels;
+    int nbThreads;
+    int numWords;
+    _Atomic int *remaining;
+    _Atomic uint64_t *ready;
+    int *counts;
+    int levelStart;
+    int levelEnd;
+    int level;
+    int done;
+    pthread_barrier_t barrier;
+} KahnShared;
 
-   if (findKeyInList(graph.array[i],str) != NULL){
-   isSource = 0;
-   break;
-   }
-   }
+/**
+ * @brief Argument of a thread of levelTopologicalSort
+ */
+typedef struct kahnTask{
+    KahnShared *shared;
+    int thread;
+} KahnTask;
 
-   if (isSource == 1){
-   graph.earliest_start[j] = 0.00;
+/**
+ * @brief Thread function of levelTopologicalSort: all the threads run the levels together
+ */
+static void* kahnTask(void *argument){
+    KahnTask *task = argument;
+    KahnShared *shared = task->shared;
+    Graph graph = shared->graph;
+    int n = graph.numberVertices;
+    int t = task->thread;
+    int firstWord = (int) ((long) shared->numWords * t / shared->nbThreads);
+    int lastWord = (int) ((long) shared->numWords * (t + 1) / shared->nbThreads);
+    int firstVertex = firstWord * 64;
+    int lastVertex = lastWord * 64 < n ? lastWord * 64 : n;
+    /* in-degrees: copied from the index of the incoming edges, or counted on the lists */
+    if (graph.incoming){
+        for (int v = firstVertex; v < lastVertex; v++){
+            atomic_store_explicit(&shared->remaining[v], graph.incoming->inDegrees[v], memory_order_relaxed);
+        }
+    }
+    else{
+        for (int v = firstVertex; v < lastVertex; v++){
+            for (Cell* tmp = graph.array[v]; tmp != NULL; tmp = tmp->nextCell){
+                atomic_fetch_add_explicit(&shared->remaining[tmp->value], 1, memory_order_relaxed);
+            }
+        }
+    }
+    pthread_barrier_wait(&shared->barrier);
+    /* the sources are the first level */
+    for (int w = firstWord; w < lastWord; w++){
+        uint64_t bits = 0;
+        int last = (w + 1) * 64 < n ? (w + 1) * 64 : n;
+        for (int v = w * 64; v < last; v++){
+            if (atomic_load_explicit(&shared->remaining[v], memory_order_relaxed) == 0){
+                bits |= (uint64_t) 1 << (v % 64);
+            }
+        }
+        atomic_store_explicit(&shared->ready[w], bits, memory_order_relaxed);
+    }
+    while (1){
+        int count = 0;
+        for (int w = firstWord; w < lastWord; w++){
+            uint64_t bits = atomic_load_explicit(&shared->ready[w], memory_order_relaxed);
+            if (bits){
+                count += __builtin_popcountll(bits);
+            }
+        }
+        shared->counts[t] = count;
+        pthread_barrier_wait(&shared->barrier);
+        /* the level is written in increasing order: each thread writes the vertices of its words */
+        int position = shared->levelEnd;
+        for (int k = 0; k < t; k++){
+            position += shared->counts[k];
+        }
+        for (int w = firstWord; w < lastWord; w++){
+            uint64_t bits = atomic_load_explicit(&shared->ready[w], memory_order_relaxed);
+            if (bits){
+                atomic_store_explicit(&shared->ready[w], 0, memory_order_relaxed);
+            }
+            while (bits){
+                int vertex = w * 64 + __builtin_ctzll(bits);
+                graph.topological_ordering[position++] = vertex;
+                shared->levels[vertex] = shared->level;
+                bits &= bits - 1;
+            }
+        }
+        pthread_barrier_wait(&shared->barrier);
+        if (t == 0){
+            int size = 0;
+            for (int k = 0; k < shared->nbThreads; k++){
+                size += shared->counts[k];
+            }
+            shared->levelStart = shared->levelEnd;
+            shared->levelEnd += size;
+            shared->level++;
+            shared->done = size == 0;
+        }
+        pthread_barrier_wait(&shared->barrier);
+        if (shared->done){
+            return NULL;
+        }
+        /* the vertices of the level remove their edges, a successor whose last edge is removed is in the next level */
+        int begin = shared->levelStart + (int) ((long) (shared->levelEnd - shared->levelStart) * t / shared->nbThreads);
+        int end = shared->levelStart + (int) ((long) (shared->levelEnd - shared->levelStart) * (t + 1) / shared->nbThreads);
+        for (int p = begin; p < end; p++){
+            for (Cell* tmp = graph.array[graph.topological_ordering[p]]; tmp != NULL; tmp = tmp->nextCell){
+                int successor = tmp->value;
+                if (atomic_fetch_sub_explicit(&shared->remaining[successor], 1, memory_order_relaxed) == 1){
+                    atomic_fetch_or_explicit(&shared->ready[successor / 64], (uint64_t) 1 << (successor % 64), memory_order_relaxed);
+                }
+            }
+        }
+        pthread_barrier_wait(&shared->barrier);
+    }
+}
 
-   }
-   else{
 
-   }
-   isSource = 1;
-   }
+/**
+ * @brief Function to perform a topological sort of a graph level by level, with several threads.
+ *
+ * @param graph The graph to be sorted.
+ * @param levels Array filled with the level of each vertex, -1 for the vertices that are not sorted.
+ * @param nbThreads The number of threads.
+ *
+ * @return The number of levels, or -1 if the graph has a cycle.
  */
-void computeEarliestStartDates(Graph graph) {
-    graph.earliest_start[graph.topological_ordering[0]] = 0.00;
-    char key[10];
-
-    for (int j = 1; j<graph.numberVertices; j++){
-        double dtot;
-        dtot = 0.00;
+int levelTopologicalSort(Graph graph, int *levels, int nbThreads){
+    int n = graph.numberVertices;
+    if (nbThreads < 1){
+        nbThreads = 1;
+    }
+    KahnShared shared;
+    shared.graph = graph;
+    shared.levels = levels;
+    shared.nbThreads = nbThreads;
+    shared.numWords = (n + 63) / 64;
+    shared.remaining = malloc(sizeof(int)*(n > 0 ? n : 1));
+    for (int i = 0; i < n; i++){
+        atomic_init(&shared.remaining[i], 0);
+        levels[i] = -1;
+        graph.topological_ordering[i] = -1;
+    }
+    shared.ready = calloc(shared.numWords + 1, sizeof(uint64_t));
+    shared.counts = malloc(sizeof(int)*nbThreads);
+    shared.levelStart = 0;
+    shared.levelEnd = 0;
+    shared.level = 0;
+    shared.done = 0;
+    pthread_barrier_init(&shared.barrier, NULL, nbThreads);
+    KahnTask *tasks = malloc(sizeof(KahnTask)*nbThreads);
+    pthread_t *threads = malloc(sizeof(pthread_t)*nbThreads);
+    for (int t = 0; t < nbThreads; t++){
+        tasks[t].shared = &shared;
+        tasks[t].thread = t;
+        if (t > 0){
+            pthread_create(&threads[t], NULL, kahnTask, &tasks[t]);
+        }
+    }
+    kahnTask(&tasks[0]);
+    for (int t = 1; t < nbThreads; t++){
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&shared.barrier);
+    free(threads);
+    free(tasks);
+    free((void *) shared.remaining);
+    free((void *) shared.ready);
+    free(shared.counts);
+    /* the last level is empty; the vertices of a cycle never reach an in-degree of 0 */
+    return shared.levelEnd == n ? shared.level - 1 : -1;
+}
 
-        for (int i = 0; i<graph.numberVertices; i++){
-            sprintf(key,"%d",graph.topological_ordering[j]);
-            if (findKeyInList(graph.array[i],key) != NULL){
-                dtot = MAX(dtot, graph.earliest_start[i] + distance(graph.xCoordinates[i],
-                            graph.yCoordinates[i],
-                            graph.xCoordinates[graph.topological_ordering[j]],
-                            graph.yCoordinates[graph.topological_ordering[j]])
-                        );
 
-            }
+/**
+ * @brief Function to compute the earliest start date of each vertex in a graph.
+ *
+ * @param graph The graph for which to compute the earliest start dates.
+ * Updates the array containing the earliest start date of each vertex in the graph structure.
+ *
+ * The dates are pushed along the edges in the topological order: when a vertex is reached,
+ * all its predecessors have been reached before, so its date is final. Each edge is read
+ * once and its length computed once, so the time is O(V+E).
+ */
+void computeEarliestStartDates(Graph graph) {
+    for (int i = 0; i<graph.numberVertices; i++){
+        graph.earliest_start[i] = 0.00;
+    }
+    for (int j = 0; j<graph.numberVertices; j++){
+        int vertex = graph.topological_ordering[j];
+        for (Cell* tmp = graph.array[vertex]; tmp != NULL; tmp = tmp->nextCell){
+            int successor = tmp->value;
+            /* MAX evaluates its arguments twice */
+            double date = graph.earliest_start[vertex] + distance(graph.xCoordinates[vertex],
+                                                                  graph.yCoordinates[vertex],
+                                                                  graph.xCoordinates[successor],
+                                                                  graph.yCoordinates[successor]);
+            graph.earliest_start[successor] = MAX(graph.earliest_start[successor], date);
         }
-
-        graph.earliest_start[graph.topological_ordering[j]] = dtot;
     }
-
     return;
 }
 
@@ -169,11 +373,11 @@ void computeLatestStartDates(Graph graph) {
             int sucessor;
             while (tmp){
                 sucessor = tmp->value;
-                dtard = MIN(dtard, graph.latest_start[sucessor] - distance(graph.xCoordinates[sucessor],
+                double date = graph.latest_start[sucessor] - distance(graph.xCoordinates[sucessor],
                             graph.yCoordinates[sucessor],
                             graph.xCoordinates[graph.topological_ordering[i]],
-                            graph.yCoordinates[graph.topological_ordering[i]]) 
-                        );
+                            graph.yCoordinates[graph.topological_ordering[i]]);
+                dtard = MIN(dtard, date);
                 tmp = tmp->nextCell;
             }
         }
@@ -184,3 +388,253 @@ void computeLatestStartDates(Graph graph) {
 
 }
 
+
+/**
+ * @brief Function to compute the earliest start date of each vertex in a weighted graph in CSR format.
+ *
+ * @param graph The graph, its weights are supposed not to be NULL and its field topological_ordering to be computed.
+ * @param earliestStart Array filled with the earliest start date of each vertex.
+ */
+void csrComputeEarliestStartDates(CSRGraph graph, double *earliestStart) {
+    for (int i = 0; i<graph.numberVertices; i++){
+        earliestStart[i] = 0.00;
+    }
+    /* the date of a vertex is final when it is reached in the topological order */
+    for (int j = 0; j<graph.numberVertices; j++){
+        int vertex = graph.topological_ordering[j];
+        for (int e = graph.offsets[vertex]; e < graph.offsets[vertex+1]; e++){
+            int successor = graph.targets[e];
+            earliestStart[successor] = MAX(earliestStart[successor], earliestStart[vertex] + graph.weights[e]);
+        }
+    }
+    return;
+}
+
+
+/**
+ * @brief Largest earliest start date of the vertices without successors
+ */
+static double largestEarliestOfWells(CSRGraph graph, const double *earliestStart){
+    double maxEarliestAmongWellVertex = 0.00;
+    for (int i = 0; i<graph.numberVertices; i++){
+        if (graph.offsets[i] == graph.offsets[i+1]){
+            maxEarliestAmongWellVertex = MAX(maxEarliestAmongWellVertex, earliestStart[i]);
+        }
+    }
+    return maxEarliestAmongWellVertex;
+}
+
+
+/**
+ * @brief Function to compute the latest start date of each vertex in a weighted graph in CSR format.
+ *
+ * @param graph The graph, its weights are supposed not to be NULL and its field topological_ordering to be computed.
+ * @param earliestStart The earliest start dates computed by csrComputeEarliestStartDates.
+ * @param latestStart Array filled with the latest start date of each vertex.
+ */
+void csrComputeLatestStartDates(CSRGraph graph, const double *earliestStart, double *latestStart) {
+    double maxEarliestAmongWellVertex = largestEarliestOfWells(graph, earliestStart);
+    for (int j = graph.numberVertices - 1; j>=0 ; j-- ){
+        int vertex = graph.topological_ordering[j];
+        double dtard = maxEarliestAmongWellVertex;
+        for (int e = graph.offsets[vertex]; e < graph.offsets[vertex+1]; e++){
+            dtard = MIN(dtard, latestStart[graph.targets[e]] - graph.weights[e]);
+        }
+        latestStart[vertex] = dtard;
+    }
+    return;
+}
+
+
+/**
+ * @brief Function to compute the start dates of a weighted graph in CSR format and keep them for updates.
+ *
+ * @param graph The graph, its weights are supposed not to be NULL and its field topological_ordering to be computed.
+ *
+ * @return The schedule.
+ */
+Schedule createSchedule(CSRGraph graph){
+    int n = graph.numberVertices;
+    int m = graph.numberEdges;
+    Schedule schedule;
+    schedule.graph = graph;
+    /* counting sort of the edges by destination, remembering the index of each edge */
+    CSRGraph predecessors;
+    predecessors.numberVertices = n;
+    predecessors.numberEdges = m;
+    predecessors.offsets = calloc(n+1, sizeof(int));
+    predecessors.targets = malloc(sizeof(int)*(m > 0 ? m : 1));
+    predecessors.weights = NULL;
+    predecessors.parents = NULL;
+    predecessors.topological_ordering = NULL;
+    schedule.predecessorEdges = malloc(sizeof(int)*(m > 0 ? m : 1));
+    for (int e = 0; e<m; e++){
+        predecessors.offsets[graph.targets[e]+1]++;
+    }
+    for (int v = 0; v<n; v++){
+        predecessors.offsets[v+1] += predecessors.offsets[v];
+    }
+    int *next = malloc(sizeof(int)*(n > 0 ? n : 1));
+    memcpy(next, predecessors.offsets, sizeof(int)*n);
+    for (int v = 0; v<n; v++){
+        for (int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+            int position = next[graph.targets[e]]++;
+            predecessors.targets[position] = v;
+            schedule.predecessorEdges[position] = e;
+        }
+    }
+    free(next);
+    schedule.predecessors = predecessors;
+    schedule.positions = malloc(sizeof(int)*(n > 0 ? n : 1));
+    for (int j = 0; j<n; j++){
+        schedule.positions[graph.topological_ordering[j]] = j;
+    }
+    schedule.earliestStart = malloc(sizeof(double)*(n > 0 ? n : 1));
+    schedule.latestStart = malloc(sizeof(double)*(n > 0 ? n : 1));
+    csrComputeEarliestStartDates(graph, schedule.earliestStart);
+    csrComputeLatestStartDates(graph, schedule.earliestStart, schedule.latestStart);
+    schedule.maxEarliest = largestEarliestOfWells(graph, schedule.earliestStart);
+    schedule.heap = createHeap(n > 0 ? n : 1);
+    return schedule;
+}
+
+
+/**
+ * @brief Function to update the start dates of a schedule after the weights of some edges have changed.
+ *
+ * @param schedule Pointer on the schedule.
+ * @param edges Indices in graph.weights of the edges whose weight has changed.
+ * @param nbEdges The number of changed edges.
+ *
+ * @return The number of dates that were recomputed.
+ */
+int updateStartDates(Schedule *schedule, const int *edges, int nbEdges){
+    CSRGraph graph = schedule->graph;
+    CSRGraph predecessors = schedule->predecessors;
+    Heap *heap = schedule->heap;
+    int recomputed = 0;
+    double maxEarliest = schedule->maxEarliest;
+    /* the origin of each edge, found by a binary search in offsets */
+    int *origins = malloc(sizeof(int)*(nbEdges > 0 ? nbEdges : 1));
+    for (int k = 0; k<nbEdges; k++){
+        int low = 0, high = graph.numberVertices - 1;
+        while (low < high){
+            int middle = low + (high - low + 1) / 2;
+            if (graph.offsets[middle] <= edges[k]){
+                low = middle;
+            }
+            else{
+                high = middle - 1;
+            }
+        }
+        origins[k] = low;
+    }
+
+    /* earliest dates: forward, the vertices being taken in the topological order */
+    for (int k = 0; k<nbEdges; k++){
+        int destination = graph.targets[edges[k]];
+        if (heap->position[destination] == -1){
+            insertHeap(heap, destination, schedule->positions[destination]);
+        }
+    }
+    int rescan = 0;
+    while (heap->nbElements){
+        int vertex = removeElement(heap);
+        recomputed++;
+        double dtot = 0.00;
+        for (int e = predecessors.offsets[vertex]; e < predecessors.offsets[vertex+1]; e++){
+            double date = schedule->earliestStart[predecessors.targets[e]] + graph.weights[schedule->predecessorEdges[e]];
+            dtot = MAX(dtot, date);
+        }
+        if (dtot == schedule->earliestStart[vertex]){
+            continue;
+        }
+        if (graph.offsets[vertex] == graph.offsets[vertex+1]){
+            /* a well: the largest date may change */
+            if (dtot > schedule->maxEarliest){
+                schedule->maxEarliest = dtot;
+            }
+            else if (schedule->earliestStart[vertex] == schedule->maxEarliest){
+                rescan = 1;
+            }
+        }
+        schedule->earliestStart[vertex] = dtot;
+        for (int e = graph.offsets[vertex]; e < graph.offsets[vertex+1]; e++){
+            int successor = graph.targets[e];
+            if (heap->position[successor] == -1){
+                insertHeap(heap, successor, schedule->positions[successor]);
+            }
+        }
+    }
+    if (rescan){
+        schedule->maxEarliest = largestEarliestOfWells(graph, schedule->earliestStart);
+    }
+
+    /* latest dates: they are all bounded by the largest earliest date, so they all change with it */
+    if (schedule->maxEarliest != maxEarliest){
+        csrComputeLatestStartDates(graph, schedule->earliestStart, schedule->latestStart);
+        free(origins);
+        return recomputed + graph.numberVertices;
+    }
+    /* otherwise backward from the origins of the edges, the vertices being taken in the reverse topological order */
+    for (int k = 0; k<nbEdges; k++){
+        if (heap->position[origins[k]] == -1){
+            insertHeap(heap, origins[k], -schedule->positions[origins[k]]);
+        }
+    }
+    while (heap->nbElements){
+        int vertex = removeElement(heap);
+        recomputed++;
+        double dtard = schedule->maxEarliest;
+        for (int e = graph.offsets[vertex]; e < graph.offsets[vertex+1]; e++){
+            double date = schedule->latestStart[graph.targets[e]] - graph.weights[e];
+            dtard = MIN(dtard, date);
+        }
+        if (dtard == schedule->latestStart[vertex]){
+            continue;
+        }
+        schedule->latestStart[vertex] = dtard;
+        for (int e = predecessors.offsets[vertex]; e < predecessors.offsets[vertex+1]; e++){
+            int predecessor = predecessors.targets[e];
+            if (heap->position[predecessor] == -1){
+                insertHeap(heap, predecessor, -schedule->positions[predecessor]);
+            }
+        }
+    }
+    free(origins);
+    return recomputed;
+}
+
+
+/**
+ * @brief Function to change the weight of an edge of a schedule and update its start dates.
+ *
+ * @param schedule Pointer on the schedule.
+ * @param edge Index of the edge in graph.weights.
+ * @param weight The new weight.
+ *
+ * @return The number of dates that were recomputed.
+ */
+int updateEdgeDuration(Schedule *schedule, int edge, EdgeWeight weight){
+    schedule->graph.weights[edge] = weight;
+    return updateStartDates(schedule, &edge, 1);
+}
+
+
+/**
+ * @brief Function to free the memory used by a schedule (the graph is not freed).
+ *
+ * @param schedule Pointer on the schedule.
+ */
+void freeSchedule(Schedule *schedule){
+    free(schedule->predecessors.offsets);
+    free(schedule->predecessors.targets);
+    free(schedule->predecessorEdges);
+    free(schedule->positions);
+    free(schedule->earliestStart);
+    free(schedule->latestStart);
+    free(schedule->heap->position);
+    free(schedule->heap->priority);
+    free(schedule->heap->heap);
+    free(schedule->heap);
+}
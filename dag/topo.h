@@ -7,6 +7,9 @@
 #ifndef TOPO_H
 #define TOPO_H
 
+#include "../graph/csrgraph.h"
+#include "../heap/heap.h"
+
 /**
  * @brief Function to perform a topological sort of a graph. Update the field topological_ordering of the graph.
  *
@@ -14,13 +17,38 @@
  */
 void topologicalSort(Graph graph) ;
 
+/**
+ * @brief Function to perform a topological sort of a graph in CSR format. Update the field topological_ordering of the graph.
+ *
+ * @param graph The graph to be sorted.
+ *
+ * Same depth first search as topologicalSort, each vertex remembering its next
+ * successor to visit, so that each edge is read once.
+ */
+void csrTopologicalSort(CSRGraph graph) ;
+
+/**
+ * @brief Function to perform a topological sort of a graph level by level (Kahn's algorithm), with several threads.
+ * @param graph The graph to be sorted. Update the field topological_ordering of the graph, the array parents is not used.
+ * @param levels Array filled with the level of each vertex: 0 for the sources, and 1 more than the largest
+ * level of its predecessors for the other vertices. The vertices of a level do not depend on each other.
+ * @param nbThreads The number of threads.
+ * @return The number of levels, or -1 if the graph has a cycle (the vertices that can't be sorted have the level -1,
+ * and the end of topological_ordering is set to -1).
+ * The ordering is the vertices of level 0, then of level 1, ..., each level in increasing order, so it does
+ * not depend on the number of threads. The vertices of a level are shared between the threads, which remove their
+ * edges with atomic decrements of the in-degrees. The in-degrees are read in the index of the incoming edges
+ * if it is tracked (see trackIncomingEdges), counted otherwise.
+ */
+int levelTopologicalSort(Graph graph, int *levels, int nbThreads);
+
 /**
  * @brief Function to compute the earliest start date of each vertex in a graph.
  *
  * @param graph The graph for which to compute the earliest start dates.
  * Updates the array containing the earliest start date of each vertex in the graph structure.
+ * The field topological_ordering is supposed to be computed. The time is O(V+E).
  */
-
 void computeEarliestStartDates(Graph graph);
 
 /**
@@ -31,4 +59,75 @@ void computeEarliestStartDates(Graph graph);
  */
 void computeLatestStartDates(Graph graph);
 
+/**
+ * @brief Function to compute the earliest start date of each vertex in a weighted graph in CSR format.
+ * @param graph The graph, its weights are supposed not to be NULL and its field topological_ordering to be computed.
+ * @param earliestStart Array filled with the earliest start date of each vertex.
+ * Same dates as computeEarliestStartDates, the duration of an edge being read in the array weights
+ * instead of being computed from the coordinates. The dates are pushed along the edges in the
+ * topological order, so each edge is read once.
+ */
+void csrComputeEarliestStartDates(CSRGraph graph, double *earliestStart);
+
+/**
+ * @brief Function to compute the latest start date of each vertex in a weighted graph in CSR format.
+ * @param graph The graph, its weights are supposed not to be NULL and its field topological_ordering to be computed.
+ * @param earliestStart The earliest start dates computed by csrComputeEarliestStartDates.
+ * @param latestStart Array filled with the latest start date of each vertex.
+ * Same dates as computeLatestStartDates, the duration of an edge being read in the array weights.
+ */
+void csrComputeLatestStartDates(CSRGraph graph, const double *earliestStart, double *latestStart);
+
+/**
+ * @brief This struct holds the start dates of a weighted graph in CSR format, kept up to date when durations change.
+ */
+typedef struct Schedule {
+    CSRGraph graph;   /** the weighted graph, with its topological ordering (not owned by the schedule). */
+    CSRGraph predecessors;   /** the predecessors of each vertex (the transposed graph). */
+    int *predecessorEdges;   /** index in graph.weights of each edge of predecessors. */
+    int *positions;   /** position of each vertex in graph.topological_ordering. */
+    double *earliestStart;   /** earliest start date of each vertex. */
+    double *latestStart;   /** latest start date of each vertex. */
+    double maxEarliest;   /** largest earliest start date of the vertices without successors. */
+    Heap *heap;   /** vertices waiting for an update, by position in the topological ordering. */
+} Schedule;
+
+/**
+ * @brief Function to compute the start dates of a weighted graph in CSR format and keep them for updates.
+ * @param graph The graph, its weights are supposed not to be NULL and its field topological_ordering to be computed.
+ * The graph must not be freed before the schedule.
+ * @return The schedule, with the dates of csrComputeEarliestStartDates and csrComputeLatestStartDates.
+ */
+Schedule createSchedule(CSRGraph graph);
+
+/**
+ * @brief Function to update the start dates of a schedule after the weights of some edges have changed.
+ * @param schedule Pointer on the schedule.
+ * @param edges Indices in graph.weights of the edges whose weight has changed (the out-edges of a vertex
+ * for a change of the duration of a task for instance).
+ * @param nbEdges The number of changed edges.
+ * @return The number of dates that were recomputed.
+ * The earliest dates are recomputed from the destinations of the edges, in the topological order, and
+ * only the successors of a vertex whose date changes are recomputed after it. The latest dates are
+ * recomputed the same way backwards from the origins of the edges, unless the largest earliest date
+ * changes: all the latest dates then change and are recomputed with csrComputeLatestStartDates.
+ * The dates are exactly the ones of a full computation.
+ */
+int updateStartDates(Schedule *schedule, const int *edges, int nbEdges);
+
+/**
+ * @brief Function to change the weight of an edge of a schedule and update its start dates.
+ * @param schedule Pointer on the schedule.
+ * @param edge Index of the edge in graph.weights.
+ * @param weight The new weight.
+ * @return The number of dates that were recomputed.
+ */
+int updateEdgeDuration(Schedule *schedule, int edge, EdgeWeight weight);
+
+/**
+ * @brief Function to free the memory used by a schedule (the graph is not freed).
+ * @param schedule Pointer on the schedule.
+ */
+void freeSchedule(Schedule *schedule);
+
 #endif  // TOPO_H
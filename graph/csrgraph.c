@@ -0,0 +1,716 @@
+/**
+ * @file csrgraph.c
+ *
+ * @brief This file implements a graph data structure in Compressed Sparse Row format.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "graph.h"
+#include "csrgraph.h"
+
+
+/**
+ * @brief Allocates a graph in CSR format without edges.
+ *
+ * The arrays offsets, targets and weights are allocated but not initialized.
+ */
+static CSRGraph allocateCSRGraph(int numVertices, int numEdges, int weighted){
+    CSRGraph graph;
+    graph.numberVertices = numVertices;
+    graph.numberEdges = numEdges;
+    graph.offsets = malloc(sizeof(int)*(numVertices+1));
+    graph.targets = malloc(sizeof(int)*(numEdges > 0 ? numEdges : 1));
+    graph.weights = weighted ? malloc(sizeof(EdgeWeight)*(numEdges > 0 ? numEdges : 1)) : NULL;
+    graph.parents = malloc(sizeof(int)*numVertices);
+    graph.topological_ordering = malloc(sizeof(int)*numVertices);
+    for (int i = 0; i<numVertices; i++){
+        graph.parents[i] = -1;
+        graph.topological_ordering[i] = -1;
+    }
+    return graph;
+}
+
+
+/**
+ * @brief Function to create a graph in CSR format from a list of oriented edges.
+ *
+ * @param numVertices The number of vertices in the graph.
+ * @param numEdges The number of edges.
+ * @param origins Origin vertex of each edge.
+ * @param destinations Destination vertex of each edge.
+ * @param weights Weight of each edge, NULL for a graph that is not weighted.
+ *
+ * @return The new graph.
+ *
+ * The successors of a vertex are stored in the order of the edges.
+ * The elements of the arrays parents and topological_ordering are set to -1.
+ */
+CSRGraph createCSRGraphFromEdges(int numVertices, int numEdges, const int *origins, const int *destinations, const double *weights){
+    CSRGraph graph = allocateCSRGraph(numVertices, numEdges, weights != NULL);
+    /* counting sort of the edges by origin */
+    memset(graph.offsets, 0, sizeof(int)*(numVertices+1));
+    for (int e = 0; e<numEdges; e++){
+        graph.offsets[origins[e]+1]++;
+    }
+    for (int v = 0; v<numVertices; v++){
+        graph.offsets[v+1] += graph.offsets[v];
+    }
+    int *next = malloc(sizeof(int)*(numVertices > 0 ? numVertices : 1));
+    memcpy(next, graph.offsets, sizeof(int)*numVertices);
+    for (int e = 0; e<numEdges; e++){
+        int position = next[origins[e]]++;
+        graph.targets[position] = destinations[e];
+        if (weights){
+            graph.weights[position] = weights[e];
+        }
+    }
+    free(next);
+    return graph;
+}
+
+
+/**
+ * @brief Function to create a graph in CSR format with the same edges as a graph of adjacency lists.
+ *
+ * @param graph The graph to convert.
+ * @param weighted If weighted!=0, the weight of an edge is the euclidean distance between its vertices.
+ *
+ * @return The new graph.
+ *
+ * The successors of a vertex are stored in the order of its adjacency list,
+ * so that the traversals of both graphs give the same trees.
+ */
+CSRGraph createCSRGraphFromGraph(Graph graph, int weighted){
+    int numEdges = 0;
+    for (int v = 0; v<graph.numberVertices; v++){
+        for (Cell* tmp = graph.array[v]; tmp != NULL; tmp = tmp->nextCell){
+            numEdges++;
+        }
+    }
+    CSRGraph csr = allocateCSRGraph(graph.numberVertices, numEdges, weighted);
+    int position = 0;
+    for (int v = 0; v<graph.numberVertices; v++){
+        csr.offsets[v] = position;
+        for (Cell* tmp = graph.array[v]; tmp != NULL; tmp = tmp->nextCell){
+            csr.targets[position] = tmp->value;
+            if (weighted){
+                csr.weights[position] = distance(graph.xCoordinates[v], graph.yCoordinates[v],
+                                                 graph.xCoordinates[tmp->value], graph.yCoordinates[tmp->value]);
+            }
+            position++;
+        }
+    }
+    csr.offsets[graph.numberVertices] = position;
+    return csr;
+}
+
+
+/**
+ * @brief Function to create a random graph in CSR format with the same procedure as createGraph.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points of the vertices.
+ * @param yCoordinates The y coordinates of the points of the vertices.
+ * @param weighted If weighted!=0, the weight of an edge is the euclidean distance between its vertices.
+ *
+ * @return The new graph.
+ *
+ * The edges are computed directly in the CSR arrays, no adjacency list is built.
+ * The neighbors are searched in a grid of the points as in createGraph, and
+ * the successors of a vertex are in increasing order.
+ */
+CSRGraph createCSRGraph(int directed, int numVertices, double sigma, const double *xCoordinates, const double *yCoordinates, int weighted){
+    CSRGraph graph = allocateCSRGraph(numVertices, 0, weighted);
+    PointGrid grid = createPointGrid(numVertices, xCoordinates, yCoordinates, sigma);
+    int *neighbors = malloc(sizeof(int)*(numVertices > 0 ? numVertices : 1));
+    int capacity = 1;
+    for (int i = 0; i<numVertices; i++){
+        graph.offsets[i] = graph.numberEdges;
+        int nbNeighbors = findNeighborsInGrid(grid, i, directed, sigma, xCoordinates, yCoordinates, neighbors);
+        while (graph.numberEdges + nbNeighbors > capacity){
+            capacity *= 2;
+            graph.targets = realloc(graph.targets, sizeof(int)*capacity);
+            if (weighted){
+                graph.weights = realloc(graph.weights, sizeof(EdgeWeight)*capacity);
+            }
+        }
+        for (int k = 0; k<nbNeighbors; k++){
+            int j = neighbors[k];
+            graph.targets[graph.numberEdges] = j;
+            if (weighted){
+                graph.weights[graph.numberEdges] = distance(xCoordinates[i], yCoordinates[i], xCoordinates[j], yCoordinates[j]);
+            }
+            graph.numberEdges++;
+        }
+    }
+    graph.offsets[numVertices] = graph.numberEdges;
+    free(neighbors);
+    freePointGrid(&grid);
+    return graph;
+}
+
+
+/**
+ * @brief Same as createCSRGraph, but the edges are computed with several threads.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points of the vertices.
+ * @param yCoordinates The y coordinates of the points of the vertices.
+ * @param weighted If weighted!=0, the weight of an edge is the euclidean distance between its vertices.
+ * @param nbThreads The number of threads.
+ *
+ * @return The new graph.
+ *
+ * The buffers of the threads cover consecutive ranges of vertices, so they are
+ * copied one after the other once the offsets are known.
+ */
+CSRGraph createCSRGraphParallel(int directed, int numVertices, double sigma, const double *xCoordinates, const double *yCoordinates, int weighted, int nbThreads){
+    if (nbThreads < 1){
+        nbThreads = 1;
+    }
+    PointGrid grid = createPointGrid(numVertices, xCoordinates, yCoordinates, sigma);
+    EdgeBuffer *buffers = findEdgesInParallel(grid, numVertices, directed, sigma, xCoordinates, yCoordinates, nbThreads);
+    freePointGrid(&grid);
+    long numEdges = 0;
+    for (int t = 0; t < nbThreads; t++){
+        numEdges += buffers[t].numberEdges;
+    }
+    CSRGraph graph = allocateCSRGraph(numVertices, (int) numEdges, weighted);
+    int edge = 0;
+    for (int t = 0; t < nbThreads; t++){
+        memcpy(graph.targets + edge, buffers[t].successors, sizeof(int)*buffers[t].numberEdges);
+        for (int i = buffers[t].begin; i<buffers[t].end; i++){
+            graph.offsets[i] = edge;
+            edge += buffers[t].degrees[i - buffers[t].begin];
+        }
+    }
+    graph.offsets[numVertices] = edge;
+    if (weighted){
+        for (int i = 0; i<numVertices; i++){
+            for (int k = graph.offsets[i]; k<graph.offsets[i+1]; k++){
+                int j = graph.targets[k];
+                graph.weights[k] = distance(xCoordinates[i], yCoordinates[i], xCoordinates[j], yCoordinates[j]);
+            }
+        }
+    }
+    freeEdgeBuffers(buffers, nbThreads);
+    return graph;
+}
+
+
+/**
+ * @brief Function to free the memory used by a graph in CSR format.
+ *
+ * @param graph Pointer on the graph to free.
+ */
+void freeCSRGraph(CSRGraph *graph){
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph->weights);
+    free(graph->parents);
+    free(graph->topological_ordering);
+    graph->offsets = NULL;
+    graph->targets = NULL;
+    graph->weights = NULL;
+    graph->parents = NULL;
+    graph->topological_ordering = NULL;
+    graph->numberVertices = 0;
+    graph->numberEdges = 0;
+}
+
+
+/**
+ * @brief Function that performs a depth first search from a vertex.
+ *
+ * @param graph The graph on which the depth first search is done.
+ * @param vertex The origin of depth first search.
+ *
+ * Same as graphDFS: the array parents is updated so that it contains the covering tree
+ * computed by the depth first search, and must be initialized before calling the function.
+ * Each vertex remembers its next successor to visit, so that each edge is read once.
+ */
+void csrGraphDFS(CSRGraph graph, int vertex){
+    /* stack of the vertices and index of the next successor to visit of each vertex of the stack */
+    int *stack = malloc(sizeof(int)*graph.numberVertices);
+    int *nextEdge = malloc(sizeof(int)*graph.numberVertices);
+    int top = 0;
+    stack[0] = vertex;
+    nextEdge[0] = graph.offsets[vertex];
+    graph.parents[vertex] = -2;
+    while (top >= 0){
+        int topStack = stack[top];
+        int end = graph.offsets[topStack+1];
+        int e = nextEdge[top];
+        while (e < end && graph.parents[graph.targets[e]] != -1){
+            e++;
+        }
+        if (e < end){
+            int successor = graph.targets[e];
+            nextEdge[top] = e + 1;
+            graph.parents[successor] = -2;
+            top++;
+            stack[top] = successor;
+            nextEdge[top] = graph.offsets[successor];
+        }
+        else {
+            graph.parents[topStack] = top == 0 ? topStack : stack[top-1];
+            top--;
+        }
+    }
+    free(stack);
+    free(nextEdge);
+}
+
+
+/**
+ * @brief Function that performs a breadth first search from a vertex.
+ *
+ * @param graph The graph on which the breadth first search is done.
+ * @param vertex The origin of breadth first search.
+ *
+ * Same as graphBFS: the array parents is updated so that it contains the covering tree
+ * computed by the breadth first search, and must be initialized before calling the function.
+ */
+void csrGraphBFS(CSRGraph graph, int vertex){
+    /* each vertex enters the queue at most once, so an array is enough */
+    int *queue = malloc(sizeof(int)*graph.numberVertices);
+    int head = 0, tail = 0;
+    graph.parents[vertex] = vertex;
+    queue[tail++] = vertex;
+    while (head < tail){
+        int vertexDequeue = queue[head++];
+        for (int e = graph.offsets[vertexDequeue]; e < graph.offsets[vertexDequeue+1]; e++){
+            int successor = graph.targets[e];
+            if (graph.parents[successor] == -1){
+                graph.parents[successor] = vertexDequeue;
+                queue[tail++] = successor;
+            }
+        }
+    }
+    free(queue);
+}
+
+
+#define BFS_ALPHA 14
+#define BFS_BETA 24
+
+/**
+ * @brief State shared by the threads of csrGraphDirectionOptimizingBFS
+ */
+typedef struct bfsShared{
+    CSRGraph graph;
+    CSRGraph incoming;
+    int nbThreads;
+    int numWords;
+    int *frontier;
+    int frontierSize;
+    int previousFrontierSize;
+    int *nextFrontier;
+    _Atomic uint64_t *current;
+    _Atomic uint64_t *next;
+    _Atomic int *claims;
+    int bottomUp;
+    long frontierEdges;
+    long edgesToCheck;
+    int *counts;
+    long *degreeSums;
+    int done;
+    pthread_barrier_t barrier;
+} BfsShared;
+
+/**
+ * @brief Argument of a thread of csrGraphDirectionOptimizingBFS
+ */
+typedef struct bfsTask{
+    BfsShared *shared;
+    int thread;
+} BfsTask;
+
+/**
+ * @brief Top-down step: the vertices of a part of the frontier claim their unvisited successors,
+ * the smallest position in the frontier wins so the result does not depend on the threads
+ */
+static void topDownStep(BfsShared *shared, int thread){
+    int begin = (int) ((long) shared->frontierSize * thread / shared->nbThreads);
+    int end = (int) ((long) shared->frontierSize * (thread + 1) / shared->nbThreads);
+    for (int p = begin; p < end; p++){
+        int vertex = shared->frontier[p];
+        for (int e = shared->graph.offsets[vertex]; e < shared->graph.offsets[vertex+1]; e++){
+            int successor = shared->graph.targets[e];
+            if (shared->graph.parents[successor] != -1){
+                continue;
+            }
+            int claim = atomic_load_explicit(&shared->claims[successor], memory_order_relaxed);
+            while (p < claim && !atomic_compare_exchange_weak_explicit(&shared->claims[successor], &claim, p,
+                                                                        memory_order_relaxed, memory_order_relaxed)){
+            }
+            if (claim == INT_MAX){
+                atomic_fetch_or_explicit(&shared->next[successor / 64], (uint64_t) 1 << (successor % 64), memory_order_relaxed);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Bottom-up step: each unvisited vertex of a range of words looks for a predecessor in the frontier,
+ * the first one in its list of predecessors becomes its parent
+ */
+static void bottomUpStep(BfsShared *shared, int firstWord, int lastWord){
+    int n = shared->graph.numberVertices;
+    for (int w = firstWord; w < lastWord; w++){
+        uint64_t found = 0;
+        int last = (w + 1) * 64 < n ? (w + 1) * 64 : n;
+        for (int vertex = w * 64; vertex < last; vertex++){
+            if (shared->graph.parents[vertex] != -1){
+                continue;
+            }
+            for (int e = shared->incoming.offsets[vertex]; e < shared->incoming.offsets[vertex+1]; e++){
+                int predecessor = shared->incoming.targets[e];
+                uint64_t word = atomic_load_explicit(&shared->current[predecessor / 64], memory_order_relaxed);
+                if (word & ((uint64_t) 1 << (predecessor % 64))){
+                    shared->graph.parents[vertex] = predecessor;
+                    found |= (uint64_t) 1 << (vertex % 64);
+                    break;
+                }
+            }
+        }
+        atomic_store_explicit(&shared->next[w], found, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Thread function of csrGraphDirectionOptimizingBFS: all the threads run the levels together
+ */
+static void* bfsTask(void *argument){
+    BfsTask *task = argument;
+    BfsShared *shared = task->shared;
+    int t = task->thread;
+    int firstWord = (int) ((long) shared->numWords * t / shared->nbThreads);
+    int lastWord = (int) ((long) shared->numWords * (t + 1) / shared->nbThreads);
+    while (1){
+        if (t == 0){
+            /* heuristic of Beamer et al.: bottom-up while the frontier is large, a bottom-up step
+               reads all the unvisited vertices so it is only chosen for a growing frontier */
+            int growing = shared->frontierSize > shared->previousFrontierSize;
+            if (!shared->bottomUp && growing && shared->frontierEdges > shared->edgesToCheck / BFS_ALPHA){
+                shared->bottomUp = 1;
+            }
+            else if (shared->bottomUp && !growing && shared->frontierSize < shared->graph.numberVertices / BFS_BETA){
+                shared->bottomUp = 0;
+            }
+        }
+        pthread_barrier_wait(&shared->barrier);
+        if (shared->bottomUp){
+            bottomUpStep(shared, firstWord, lastWord);
+        }
+        else{
+            topDownStep(shared, t);
+        }
+        pthread_barrier_wait(&shared->barrier);
+        int count = 0;
+        for (int w = firstWord; w < lastWord; w++){
+            uint64_t bits = atomic_load_explicit(&shared->next[w], memory_order_relaxed);
+            if (bits){
+                count += __builtin_popcountll(bits);
+            }
+        }
+        shared->counts[t] = count;
+        pthread_barrier_wait(&shared->barrier);
+        /* the next frontier is sorted by vertex: each thread writes the vertices of its words */
+        int position = 0;
+        for (int k = 0; k < t; k++){
+            position += shared->counts[k];
+        }
+        long degrees = 0;
+        for (int w = firstWord; w < lastWord; w++){
+            uint64_t bits = atomic_load_explicit(&shared->next[w], memory_order_relaxed);
+            while (bits){
+                int vertex = w * 64 + __builtin_ctzll(bits);
+                if (!shared->bottomUp){
+                    int claim = atomic_load_explicit(&shared->claims[vertex], memory_order_relaxed);
+                    shared->graph.parents[vertex] = shared->frontier[claim];
+                }
+                shared->nextFrontier[position++] = vertex;
+                degrees += shared->graph.offsets[vertex+1] - shared->graph.offsets[vertex];
+                bits &= bits - 1;
+            }
+            /* the bitmap of the frontier is emptied to receive the level after the next one */
+            if (atomic_load_explicit(&shared->current[w], memory_order_relaxed)){
+                atomic_store_explicit(&shared->current[w], 0, memory_order_relaxed);
+            }
+        }
+        shared->degreeSums[t] = degrees;
+        pthread_barrier_wait(&shared->barrier);
+        if (t == 0){
+            int *frontier = shared->frontier;
+            shared->frontier = shared->nextFrontier;
+            shared->nextFrontier = frontier;
+            _Atomic uint64_t *current = shared->current;
+            shared->current = shared->next;
+            shared->next = current;
+            shared->previousFrontierSize = shared->frontierSize;
+            shared->frontierSize = 0;
+            shared->frontierEdges = 0;
+            for (int k = 0; k < shared->nbThreads; k++){
+                shared->frontierSize += shared->counts[k];
+                shared->frontierEdges += shared->degreeSums[k];
+            }
+            shared->edgesToCheck -= shared->frontierEdges;
+            shared->done = shared->frontierSize == 0;
+        }
+        pthread_barrier_wait(&shared->barrier);
+        if (shared->done){
+            return NULL;
+        }
+    }
+}
+
+
+/**
+ * @brief Function that performs a breadth first search level by level, with several threads.
+ *
+ * @param graph The graph on which the breadth first search is done.
+ * @param incoming Pointer on the graph of the predecessors (the transpose of graph), NULL if graph is undirected.
+ * @param vertex The origin of breadth first search.
+ * @param nbThreads The number of threads.
+ */
+void csrGraphDirectionOptimizingBFS(CSRGraph graph, const CSRGraph *incoming, int vertex, int nbThreads){
+    int n = graph.numberVertices;
+    if (nbThreads < 1){
+        nbThreads = 1;
+    }
+    BfsShared shared;
+    shared.graph = graph;
+    shared.incoming = incoming != NULL ? *incoming : graph;
+    shared.nbThreads = nbThreads;
+    shared.numWords = (n + 63) / 64;
+    shared.frontier = malloc(sizeof(int)*(n > 0 ? n : 1));
+    shared.nextFrontier = malloc(sizeof(int)*(n > 0 ? n : 1));
+    shared.current = calloc(shared.numWords + 1, sizeof(uint64_t));
+    shared.next = calloc(shared.numWords + 1, sizeof(uint64_t));
+    shared.claims = malloc(sizeof(int)*(n > 0 ? n : 1));
+    for (int i = 0; i < n; i++){
+        atomic_init(&shared.claims[i], INT_MAX);
+    }
+    shared.counts = malloc(sizeof(int)*nbThreads);
+    shared.degreeSums = malloc(sizeof(long)*nbThreads);
+    graph.parents[vertex] = vertex;
+    shared.frontier[0] = vertex;
+    shared.frontierSize = 1;
+    shared.previousFrontierSize = 0;
+    atomic_store(&shared.current[vertex / 64], (uint64_t) 1 << (vertex % 64));
+    shared.bottomUp = 0;
+    shared.frontierEdges = graph.offsets[vertex+1] - graph.offsets[vertex];
+    shared.edgesToCheck = graph.numberEdges - shared.frontierEdges;
+    shared.done = 0;
+    pthread_barrier_init(&shared.barrier, NULL, nbThreads);
+    BfsTask *tasks = malloc(sizeof(BfsTask)*nbThreads);
+    pthread_t *threads = malloc(sizeof(pthread_t)*nbThreads);
+    for (int t = 0; t < nbThreads; t++){
+        tasks[t].shared = &shared;
+        tasks[t].thread = t;
+        if (t > 0){
+            pthread_create(&threads[t], NULL, bfsTask, &tasks[t]);
+        }
+    }
+    bfsTask(&tasks[0]);
+    for (int t = 1; t < nbThreads; t++){
+        pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&shared.barrier);
+    free(threads);
+    free(tasks);
+    free(shared.frontier);
+    free(shared.nextFrontier);
+    free((void *) shared.current);
+    free((void *) shared.next);
+    free((void *) shared.claims);
+    free(shared.counts);
+    free(shared.degreeSums);
+}
+
+
+/**
+ * @brief Argument of the threads of csrConnectedComponents
+ */
+typedef struct componentsTask{
+    CSRGraph graph;
+    _Atomic int *labels;
+    int begin;
+    int end;
+    int *forestOrigins;
+    int *forestDestinations;
+    int forestSize;
+} ComponentsTask;
+
+/**
+ * @brief Root of the tree of a vertex in the concurrent union-find, halving the path on the way
+ */
+static int findRoot(_Atomic int *labels, int vertex){
+    int parent = atomic_load_explicit(&labels[vertex], memory_order_relaxed);
+    while (parent != vertex){
+        int grandParent = atomic_load_explicit(&labels[parent], memory_order_relaxed);
+        if (grandParent != parent){
+            /* may fail if another thread changed the label, which is harmless */
+            atomic_compare_exchange_weak_explicit(&labels[vertex], &parent, grandParent,
+                                                  memory_order_relaxed, memory_order_relaxed);
+        }
+        vertex = parent;
+        parent = atomic_load_explicit(&labels[vertex], memory_order_relaxed);
+    }
+    return vertex;
+}
+
+/**
+ * @brief Merges the trees of two vertices, the largest root is linked to the smallest one,
+ * returns 1 if the trees were different
+ */
+static int unionRoots(_Atomic int *labels, int first, int second){
+    while (1){
+        int root1 = findRoot(labels, first);
+        int root2 = findRoot(labels, second);
+        if (root1 == root2){
+            return 0;
+        }
+        if (root1 < root2){
+            int tmp = root1;
+            root1 = root2;
+            root2 = tmp;
+        }
+        /* the link fails if root1 is not a root anymore, then the roots are searched again */
+        int expected = root1;
+        if (atomic_compare_exchange_strong_explicit(&labels[root1], &expected, root2,
+                                                    memory_order_relaxed, memory_order_relaxed)){
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief Thread function of csrConnectedComponents: merges the trees of the edges of a range of vertices
+ */
+static void* componentsTask(void *argument){
+    ComponentsTask *task = argument;
+    for (int vertex = task->begin; vertex < task->end; vertex++){
+        for (int e = task->graph.offsets[vertex]; e < task->graph.offsets[vertex+1]; e++){
+            int successor = task->graph.targets[e];
+            if (unionRoots(task->labels, vertex, successor) && task->forestOrigins != NULL){
+                task->forestOrigins[task->forestSize] = vertex;
+                task->forestDestinations[task->forestSize] = successor;
+                task->forestSize++;
+            }
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Function that computes the connected components of a graph with several threads.
+ *
+ * @param graph The graph.
+ * @param components Array of numberVertices integers filled with the component of each vertex.
+ * @param nbThreads The number of threads.
+ * @param forest If forest!=0, the array parents is filled with a covering forest.
+ *
+ * @return The number of connected components.
+ */
+int csrConnectedComponents(CSRGraph graph, int *components, int nbThreads, int forest){
+    int n = graph.numberVertices;
+    if (nbThreads < 1){
+        nbThreads = 1;
+    }
+    _Atomic int *labels = malloc(sizeof(int)*(n > 0 ? n : 1));
+    for (int i = 0; i<n; i++){
+        atomic_init(&labels[i], i);
+    }
+    ComponentsTask *tasks = malloc(sizeof(ComponentsTask)*nbThreads);
+    pthread_t *threads = malloc(sizeof(pthread_t)*nbThreads);
+    for (int t = 0; t < nbThreads; t++){
+        tasks[t].graph = graph;
+        tasks[t].labels = labels;
+        tasks[t].begin = (int) ((long) n * t / nbThreads);
+        tasks[t].end = (int) ((long) n * (t + 1) / nbThreads);
+        /* each successful union is an edge of the forest, there are less than n of them */
+        tasks[t].forestOrigins = forest ? malloc(sizeof(int)*(n > 0 ? n : 1)) : NULL;
+        tasks[t].forestDestinations = forest ? malloc(sizeof(int)*(n > 0 ? n : 1)) : NULL;
+        tasks[t].forestSize = 0;
+        if (t > 0){
+            pthread_create(&threads[t], NULL, componentsTask, &tasks[t]);
+        }
+    }
+    componentsTask(&tasks[0]);
+    for (int t = 1; t < nbThreads; t++){
+        pthread_join(threads[t], NULL);
+    }
+    /* the root of a tree is the smallest vertex of its component */
+    int nbComponents = 0;
+    for (int i = 0; i<n; i++){
+        components[i] = findRoot(labels, i);
+        if (components[i] == i){
+            nbComponents++;
+        }
+    }
+    if (forest){
+        int forestSize = 0;
+        for (int t = 0; t < nbThreads; t++){
+            forestSize += tasks[t].forestSize;
+        }
+        int *origins = malloc(sizeof(int)*(2*forestSize > 0 ? 2*forestSize : 1));
+        int *destinations = malloc(sizeof(int)*(2*forestSize > 0 ? 2*forestSize : 1));
+        int position = 0;
+        for (int t = 0; t < nbThreads; t++){
+            for (int k = 0; k < tasks[t].forestSize; k++){
+                origins[position] = destinations[position+1] = tasks[t].forestOrigins[k];
+                destinations[position] = origins[position+1] = tasks[t].forestDestinations[k];
+                position += 2;
+            }
+        }
+        /* the trees of the forest are oriented from the root of each component */
+        CSRGraph trees = createCSRGraphFromEdges(n, 2*forestSize, origins, destinations, NULL);
+        free(origins);
+        free(destinations);
+        /* one queue for all the trees, since a BFS by component would allocate it for each component */
+        int *queue = malloc(sizeof(int)*(n > 0 ? n : 1));
+        int head = 0, tail = 0;
+        for (int i = 0; i<n; i++){
+            graph.parents[i] = -1;
+        }
+        for (int i = 0; i<n; i++){
+            if (components[i] == i){
+                graph.parents[i] = i;
+                queue[tail++] = i;
+            }
+        }
+        while (head < tail){
+            int vertexDequeue = queue[head++];
+            for (int e = trees.offsets[vertexDequeue]; e < trees.offsets[vertexDequeue+1]; e++){
+                int successor = trees.targets[e];
+                if (graph.parents[successor] == -1){
+                    graph.parents[successor] = vertexDequeue;
+                    queue[tail++] = successor;
+                }
+            }
+        }
+        free(queue);
+        freeCSRGraph(&trees);
+    }
+    for (int t = 0; t < nbThreads; t++){
+        free(tasks[t].forestOrigins);
+        free(tasks[t].forestDestinations);
+    }
+    free(tasks);
+    free(threads);
+    free((void *) labels);
+    return nbComponents;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file csrgraph.h
+ *
+ * @brief This file defines a graph data structure in Compressed Sparse Row format.
+ */
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "graph.h"
+
+
+/**
+ * @brief Type of the weights of the edges of a graph in CSR format.
+ *
+ * The weights are double by default, and float if CSR_FLOAT_WEIGHTS is defined
+ * (half the memory read by the algorithms that use the weights, with a relative
+ * error of about 1e-7 on each weight).
+ */
+#ifdef CSR_FLOAT_WEIGHTS
+typedef float EdgeWeight;
+#else
+typedef double EdgeWeight;
+#endif
+
+
+/**
+ * @brief This struct represents a graph in Compressed Sparse Row format.
+ *
+ * The successors of the vertex v are targets[offsets[v]], ..., targets[offsets[v+1]-1],
+ * so that a traversal reads two contiguous arrays instead of following a list of cells.
+ */
+typedef struct CSRGraph {
+    int numberVertices;   /** The number of vertices in the graph. */
+    int numberEdges;   /** The number of oriented edges in the graph. */
+    int *offsets;   /** array of numberVertices+1 indices of the first successor of each vertex in targets. */
+    int *targets;   /** array of the successors of all the vertices. */
+    EdgeWeight *weights;   /** weight of each edge (same index as targets), NULL if the graph is not weighted. */
+
+    int *parents; /** array to store the parent of each node for the covering tree. */
+    int *topological_ordering; /** array to store a topological ordering of the graph. */
+} CSRGraph;
+
+
+/**
+ * @brief Function to create a graph in CSR format from a list of oriented edges.
+ *
+ * @param numVertices The number of vertices in the graph.
+ * @param numEdges The number of edges.
+ * @param origins Origin vertex of each edge.
+ * @param destinations Destination vertex of each edge.
+ * @param weights Weight of each edge (converted to EdgeWeight), NULL for a graph that is not weighted.
+ *
+ * @return The new graph.
+ *
+ * The successors of a vertex are stored in the order of the edges.
+ * The elements of the arrays parents and topological_ordering are set to -1.
+ */
+CSRGraph createCSRGraphFromEdges(int numVertices, int numEdges, const int *origins, const int *destinations, const double *weights);
+
+/**
+ * @brief Function to create a graph in CSR format with the same edges as a graph of adjacency lists.
+ *
+ * @param graph The graph to convert.
+ * @param weighted If weighted!=0, the weight of an edge is the euclidean distance between its vertices.
+ *
+ * @return The new graph.
+ *
+ * The successors of a vertex are stored in the order of its adjacency list,
+ * so that the traversals of both graphs give the same trees.
+ */
+CSRGraph createCSRGraphFromGraph(Graph graph, int weighted);
+
+/**
+ * @brief Function to create a random graph in CSR format with the same procedure as createGraph.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points of the vertices.
+ * @param yCoordinates The y coordinates of the points of the vertices.
+ * @param weighted If weighted!=0, the weight of an edge is the euclidean distance between its vertices.
+ *
+ * @return The new graph.
+ *
+ * The edges are computed directly in the CSR arrays, no adjacency list is built.
+ * The successors of a vertex are in increasing order.
+ */
+CSRGraph createCSRGraph(int directed, int numVertices, double sigma, const double *xCoordinates, const double *yCoordinates, int weighted);
+
+/**
+ * @brief Same as createCSRGraph, but the edges are computed with several threads.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points of the vertices.
+ * @param yCoordinates The y coordinates of the points of the vertices.
+ * @param weighted If weighted!=0, the weight of an edge is the euclidean distance between its vertices.
+ * @param nbThreads The number of threads.
+ *
+ * @return The new graph, the same as the one of createCSRGraph whatever the number of threads.
+ */
+CSRGraph createCSRGraphParallel(int directed, int numVertices, double sigma, const double *xCoordinates, const double *yCoordinates, int weighted, int nbThreads);
+
+/**
+ * @brief Function to free the memory used by a graph in CSR format.
+ *
+ * @param graph Pointer on the graph to free.
+ */
+void freeCSRGraph(CSRGraph *graph);
+
+/**
+ * @brief Function that performs a depth first search from a vertex.
+ *
+ * @param graph The graph on which the depth first search is done.
+ * @param vertex The origin of depth first search.
+ *
+ * Same as graphDFS: the array parents is updated so that it contains the covering tree
+ * computed by the depth first search, and must be initialized before calling the function.
+ * Each vertex remembers its next successor to visit, so that each edge is read once.
+ */
+void csrGraphDFS(CSRGraph graph, int vertex);
+
+/**
+ * @brief Function that performs a breadth first search from a vertex.
+ *
+ * @param graph The graph on which the breadth first search is done.
+ * @param vertex The origin of breadth first search.
+ *
+ * Same as graphBFS: the array parents is updated so that it contains the covering tree
+ * computed by the breadth first search, and must be initialized before calling the function.
+ */
+void csrGraphBFS(CSRGraph graph, int vertex);
+
+/**
+ * @brief Function that performs a breadth first search level by level, with several threads.
+ *
+ * @param graph The graph on which the breadth first search is done.
+ * @param incoming Pointer on the graph of the predecessors (the transpose of graph), NULL if graph is undirected.
+ * @param vertex The origin of breadth first search.
+ * @param nbThreads The number of threads.
+ *
+ * Same contract as csrGraphBFS: the array parents must be initialized to -1 and the parent of the
+ * origin is itself. The parent of a vertex is a vertex of the previous level, so the levels are the
+ * ones of csrGraphBFS, and the tree does not depend on the number of threads.
+ * The frontiers are arrays and bitmaps. A level is explored top-down (the frontier visits its successors)
+ * while the frontier is small, and bottom-up (the unvisited vertices look for a predecessor in the
+ * frontier) while it is large, which skips most of the edges of the large levels.
+ */
+void csrGraphDirectionOptimizingBFS(CSRGraph graph, const CSRGraph *incoming, int vertex, int nbThreads);
+
+/**
+ * @brief Function that computes the connected components of a graph with several threads.
+ *
+ * @param graph The graph (the components of a directed graph are its weakly connected components).
+ * @param components Array of numberVertices integers filled with the component of each vertex,
+ * which is the smallest vertex of the component.
+ * @param nbThreads The number of threads.
+ * @param forest If forest!=0, the array parents is filled with a covering forest (one tree by component,
+ * the root is the smallest vertex of the component and is its own parent), otherwise parents is not used.
+ *
+ * @return The number of connected components.
+ *
+ * The threads share a union-find structure: each thread merges the trees of the ends of the edges
+ * of a range of vertices with compare-and-swap, so no lock is needed. A tree is always linked under
+ * a smaller root, so the components do not depend on the number of threads.
+ */
+int csrConnectedComponents(CSRGraph graph, int *components, int nbThreads, int forest);
+
+#endif  // CSRGRAPH_H
@@ -8,10 +8,16 @@
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
+#include <stdint.h>
+#include <pthread.h>
 #include "graph.h"
 #include "../stack/stack.h"
 #include "../queue/queue.h"
 #include "../list/list.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GRAPH_X86_KERNELS
+#endif
 /**
  * @brief Computes the Euclidean distance between two points.
  *
@@ -26,6 +32,226 @@ double distance(double x1, double y1, double x2, double y2){
 }
 
 
+/*
+ * Batch kernels of pointsWithinDistance.
+ *
+ * The squared distance s = dx*dx+dy*dy is compared with sigma^2. Since s and
+ * sigma^2 are rounded, a point with s in a thin band around sigma^2 is checked
+ * again with distance(), so that the result is exactly the one of distance().
+ */
+
+/**
+ * @brief Relative width of the band around sigma^2 where distance() decides
+ */
+#define DISTANCE_BAND 1e-12
+
+/**
+ * @brief Decides for one point given its squared distance s to the query point
+ */
+static inline int isWithinDistance(double s, double low, double high, double x, double y, double xk, double yk, double sigma, int inclusive){
+    if (s < low){
+        return 1;
+    }
+    if (s > high){
+        return 0;
+    }
+    double d = distance(x, y, xk, yk);
+    return inclusive ? d <= sigma : d < sigma;
+}
+
+/**
+ * @brief Scalar version of pointsWithinDistance
+ */
+static int pointsWithinDistanceScalar(double x, double y, const double *xCoordinates, const double *yCoordinates,
+                                      int begin, int end, double sigma, int inclusive, int *indices){
+    double low = sigma*sigma*(1-DISTANCE_BAND);
+    double high = sigma*sigma*(1+DISTANCE_BAND);
+    int count = 0;
+    for (int k = begin; k<end; k++){
+        double dx = x - xCoordinates[k];
+        double dy = y - yCoordinates[k];
+        if (isWithinDistance(dx*dx + dy*dy, low, high, x, y, xCoordinates[k], yCoordinates[k], sigma, inclusive)){
+            indices[count++] = k;
+        }
+    }
+    return count;
+}
+
+#ifdef GRAPH_X86_KERNELS
+/**
+ * @brief SSE2 version of pointsWithinDistance, 2 points per step
+ */
+__attribute__((target("sse2")))
+static int pointsWithinDistanceSSE2(double x, double y, const double *xCoordinates, const double *yCoordinates,
+                                    int begin, int end, double sigma, int inclusive, int *indices){
+    double low = sigma*sigma*(1-DISTANCE_BAND);
+    double high = sigma*sigma*(1+DISTANCE_BAND);
+    __m128d vx = _mm_set1_pd(x), vy = _mm_set1_pd(y);
+    __m128d vlow = _mm_set1_pd(low), vhigh = _mm_set1_pd(high);
+    int count = 0;
+    int k = begin;
+    for (; k+2 <= end; k += 2){
+        __m128d dx = _mm_sub_pd(vx, _mm_loadu_pd(xCoordinates+k));
+        __m128d dy = _mm_sub_pd(vy, _mm_loadu_pd(yCoordinates+k));
+        __m128d squared = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        int candidates = _mm_movemask_pd(_mm_cmple_pd(squared, vhigh));
+        if (candidates == 0){
+            continue;
+        }
+        int inside = _mm_movemask_pd(_mm_cmplt_pd(squared, vlow));
+        for (int lane = 0; lane < 2; lane++){
+            if (inside & (1 << lane)){
+                indices[count++] = k + lane;
+            }
+            else if (candidates & (1 << lane)){
+                double d = distance(x, y, xCoordinates[k+lane], yCoordinates[k+lane]);
+                if (inclusive ? d <= sigma : d < sigma){
+                    indices[count++] = k + lane;
+                }
+            }
+        }
+    }
+    return count + pointsWithinDistanceScalar(x, y, xCoordinates, yCoordinates, k, end, sigma, inclusive, indices + count);
+}
+
+/**
+ * @brief AVX2 version of pointsWithinDistance, 4 points per step
+ */
+__attribute__((target("avx2")))
+static int pointsWithinDistanceAVX2(double x, double y, const double *xCoordinates, const double *yCoordinates,
+                                    int begin, int end, double sigma, int inclusive, int *indices){
+    double low = sigma*sigma*(1-DISTANCE_BAND);
+    double high = sigma*sigma*(1+DISTANCE_BAND);
+    __m256d vx = _mm256_set1_pd(x), vy = _mm256_set1_pd(y);
+    __m256d vlow = _mm256_set1_pd(low), vhigh = _mm256_set1_pd(high);
+    int count = 0;
+    int k = begin;
+    for (; k+4 <= end; k += 4){
+        __m256d dx = _mm256_sub_pd(vx, _mm256_loadu_pd(xCoordinates+k));
+        __m256d dy = _mm256_sub_pd(vy, _mm256_loadu_pd(yCoordinates+k));
+        __m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        int candidates = _mm256_movemask_pd(_mm256_cmp_pd(squared, vhigh, _CMP_LE_OQ));
+        if (candidates == 0){
+            continue;
+        }
+        int inside = _mm256_movemask_pd(_mm256_cmp_pd(squared, vlow, _CMP_LT_OQ));
+        for (int lane = 0; lane < 4; lane++){
+            if (inside & (1 << lane)){
+                indices[count++] = k + lane;
+            }
+            else if (candidates & (1 << lane)){
+                double d = distance(x, y, xCoordinates[k+lane], yCoordinates[k+lane]);
+                if (inclusive ? d <= sigma : d < sigma){
+                    indices[count++] = k + lane;
+                }
+            }
+        }
+    }
+    return count + pointsWithinDistanceScalar(x, y, xCoordinates, yCoordinates, k, end, sigma, inclusive, indices + count);
+}
+#endif
+
+/**
+ * @brief Kernel used by pointsWithinDistance, -1 until the first call
+ */
+static int distanceKernel = -1;
+
+
+/**
+ * @brief Function to choose the kernel of pointsWithinDistance.
+ *
+ * @param kernel The requested kernel.
+ *
+ * @return The kernel that is used: the requested one if the processor supports it,
+ * the best supported one below it otherwise.
+ */
+DistanceKernel selectDistanceKernel(DistanceKernel kernel){
+    distanceKernel = DISTANCE_KERNEL_SCALAR;
+#ifdef GRAPH_X86_KERNELS
+    if (kernel >= DISTANCE_KERNEL_AVX2 && __builtin_cpu_supports("avx2")){
+        distanceKernel = DISTANCE_KERNEL_AVX2;
+    }
+    else if (kernel >= DISTANCE_KERNEL_SSE2 && __builtin_cpu_supports("sse2")){
+        distanceKernel = DISTANCE_KERNEL_SSE2;
+    }
+#endif
+    return distanceKernel;
+}
+
+
+/**
+ * @brief Function to find the points of a block that are close to a point.
+ *
+ * @param x x coordinate of the point.
+ * @param y y coordinate of the point.
+ * @param xCoordinates The x coordinates of the points of the block.
+ * @param yCoordinates The y coordinates of the points of the block.
+ * @param begin Index of the first point of the block.
+ * @param end Index after the last point of the block.
+ * @param sigma The maximal distance.
+ * @param inclusive If inclusive==0, the distance must be less than sigma, otherwise less or equal.
+ * @param indices Array (of size at least end-begin) filled with the indices of the close points in increasing order.
+ *
+ * @return The number of close points.
+ *
+ * The result is exactly the one of a loop testing distance() for each point.
+ */
+int pointsWithinDistance(double x, double y, const double *xCoordinates, const double *yCoordinates,
+                         int begin, int end, double sigma, int inclusive, int *indices){
+    if (distanceKernel < 0){
+        selectDistanceKernel(DISTANCE_KERNEL_AVX2);
+    }
+#ifdef GRAPH_X86_KERNELS
+    if (distanceKernel == DISTANCE_KERNEL_AVX2){
+        return pointsWithinDistanceAVX2(x, y, xCoordinates, yCoordinates, begin, end, sigma, inclusive, indices);
+    }
+    if (distanceKernel == DISTANCE_KERNEL_SSE2){
+        return pointsWithinDistanceSSE2(x, y, xCoordinates, yCoordinates, begin, end, sigma, inclusive, indices);
+    }
+#endif
+    return pointsWithinDistanceScalar(x, y, xCoordinates, yCoordinates, begin, end, sigma, inclusive, indices);
+}
+
+
+/**
+ * @brief Root of the tree of a vertex in a union-find structure, the path to the root is compressed
+ */
+static int findRepresentative(Connectivity *connectivity, int vertex){
+    int *representatives = connectivity->representatives;
+    int root = vertex;
+    while (representatives[root] != root){
+        root = representatives[root];
+    }
+    while (representatives[vertex] != root){
+        int next = representatives[vertex];
+        representatives[vertex] = root;
+        vertex = next;
+    }
+    return root;
+}
+
+/**
+ * @brief Merges the components of two vertices, the tree of lower rank is linked under the other root
+ */
+static void mergeComponents(Connectivity *connectivity, int first, int second){
+    int root1 = findRepresentative(connectivity, first);
+    int root2 = findRepresentative(connectivity, second);
+    if (root1 == root2){
+        return;
+    }
+    if (connectivity->ranks[root1] < connectivity->ranks[root2]){
+        int tmp = root1;
+        root1 = root2;
+        root2 = tmp;
+    }
+    connectivity->representatives[root2] = root1;
+    if (connectivity->ranks[root1] == connectivity->ranks[root2]){
+        connectivity->ranks[root1]++;
+    }
+    connectivity->numberComponents--;
+}
+
+
 /**
  * @brief Function to add an oriented edge in a graph.
  *
@@ -33,37 +259,341 @@ double distance(double x1, double y1, double x2, double y2){
  * @param destination Destination vrtex of the edge.
  * @param graph The graph in which the edge is added.
  *
- * Only the array of adjacency lists is updated.
+ * Only the array of adjacency lists is updated, and the components and the predecessors if they are tracked.
  */
 void addEdgeInGraph(Graph graph, int origin, int destination) {
     char key[10];
     sprintf(key,"%d", destination);
     graph.array[origin] = addKeyValueInList(graph.array[origin],key,destination);
+    if (graph.connectivity){
+        mergeComponents(graph.connectivity, origin, destination);
+    }
+    if (graph.incoming){
+        IncomingEdges *incoming = graph.incoming;
+        if (incoming->inDegrees[destination] == incoming->capacities[destination]){
+            incoming->capacities[destination] = incoming->capacities[destination] > 0 ? 2*incoming->capacities[destination] : 4;
+            incoming->predecessors[destination] = realloc(incoming->predecessors[destination],
+                                                          sizeof(int)*incoming->capacities[destination]);
+        }
+        incoming->predecessors[destination][incoming->inDegrees[destination]++] = origin;
+    }
     return;
 }
 
 
 /**
- * @brief Function to create a random graph with a specified number of vertices and parameter sigma.
+ * @brief Function to add a vertex in a graph, with its edges to the close points.
+ *
+ * @param graph Pointer on the graph in which the vertex is added.
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param x x coordinate of the point of the vertex.
+ * @param y y coordinate of the point of the vertex.
+ *
+ * @return The new vertex, numbered graph->numberVertices-1.
+ */
+int addVertexInGraph(Graph *graph, int directed, double x, double y){
+    int vertex = graph->numberVertices;
+    if (vertex == graph->capacity){
+        int capacity = graph->capacity > 0 ? 2*graph->capacity : 16;
+        graph->array = realloc(graph->array, sizeof(List)*capacity);
+        graph->xCoordinates = realloc(graph->xCoordinates, sizeof(double)*capacity);
+        graph->yCoordinates = realloc(graph->yCoordinates, sizeof(double)*capacity);
+        graph->parents = realloc(graph->parents, sizeof(int)*capacity);
+        graph->topological_ordering = realloc(graph->topological_ordering, sizeof(int)*capacity);
+        graph->earliest_start = realloc(graph->earliest_start, sizeof(double)*capacity);
+        graph->latest_start = realloc(graph->latest_start, sizeof(double)*capacity);
+        if (graph->connectivity){
+            graph->connectivity->representatives = realloc(graph->connectivity->representatives, sizeof(int)*capacity);
+            graph->connectivity->ranks = realloc(graph->connectivity->ranks, sizeof(int)*capacity);
+        }
+        if (graph->incoming){
+            graph->incoming->inDegrees = realloc(graph->incoming->inDegrees, sizeof(int)*capacity);
+            graph->incoming->capacities = realloc(graph->incoming->capacities, sizeof(int)*capacity);
+            graph->incoming->predecessors = realloc(graph->incoming->predecessors, sizeof(int*)*capacity);
+        }
+        graph->capacity = capacity;
+    }
+    graph->array[vertex] = newList();
+    graph->xCoordinates[vertex] = x;
+    graph->yCoordinates[vertex] = y;
+    graph->parents[vertex] = -1;
+    graph->topological_ordering[vertex] = -1;
+    graph->earliest_start[vertex] = -1.00;
+    graph->latest_start[vertex] = -1.00;
+    if (graph->connectivity){
+        graph->connectivity->representatives[vertex] = vertex;
+        graph->connectivity->ranks[vertex] = 0;
+        graph->connectivity->numberComponents++;
+    }
+    if (graph->incoming){
+        graph->incoming->inDegrees[vertex] = 0;
+        graph->incoming->capacities[vertex] = 0;
+        graph->incoming->predecessors[vertex] = NULL;
+    }
+    graph->numberVertices++;
+    /* the points are tested by blocks, the new vertex is the largest one so it is added at the head of the lists
+       as in createGraph */
+    int indices[256];
+    for (int begin = 0; begin < vertex; begin += 256){
+        int end = begin + 256 < vertex ? begin + 256 : vertex;
+        int count = pointsWithinDistance(x, y, graph->xCoordinates, graph->yCoordinates, begin, end, graph->sigma, 0, indices);
+        for (int m = 0; m < count; m++){
+            int k = indices[m];
+            if (directed == 0 || graph->yCoordinates[k] < y){
+                addEdgeInGraph(*graph, k, vertex);
+            }
+            if (directed == 0 || y < graph->yCoordinates[k]){
+                addEdgeInGraph(*graph, vertex, k);
+            }
+        }
+    }
+    return vertex;
+}
+
+
+/**
+ * @brief Function to maintain the connected components of a graph while it grows.
+ *
+ * @param graph Pointer on the graph.
+ */
+void trackConnectivity(Graph *graph){
+    if (graph->connectivity){
+        return;
+    }
+    int capacity = graph->capacity > 0 ? graph->capacity : 1;
+    Connectivity *connectivity = malloc(sizeof(Connectivity));
+    connectivity->representatives = malloc(sizeof(int)*capacity);
+    connectivity->ranks = malloc(sizeof(int)*capacity);
+    connectivity->numberComponents = graph->numberVertices;
+    for (int i = 0; i<graph->numberVertices; i++){
+        connectivity->representatives[i] = i;
+        connectivity->ranks[i] = 0;
+    }
+    for (int i = 0; i<graph->numberVertices; i++){
+        for (Cell* tmp = graph->array[i]; tmp != NULL; tmp = tmp->nextCell){
+            mergeComponents(connectivity, i, tmp->value);
+        }
+    }
+    graph->connectivity = connectivity;
+}
+
+
+/**
+ * @brief Function to maintain the predecessors of the vertices of a graph while it grows.
+ *
+ * @param graph Pointer on the graph.
+ */
+void trackIncomingEdges(Graph *graph){
+    if (graph->incoming){
+        return;
+    }
+    int capacity = graph->capacity > 0 ? graph->capacity : 1;
+    IncomingEdges *incoming = malloc(sizeof(IncomingEdges));
+    incoming->inDegrees = malloc(sizeof(int)*capacity);
+    incoming->capacities = malloc(sizeof(int)*capacity);
+    incoming->predecessors = malloc(sizeof(int*)*capacity);
+    for (int i = 0; i<graph->numberVertices; i++){
+        incoming->inDegrees[i] = 0;
+    }
+    for (int i = 0; i<graph->numberVertices; i++){
+        for (Cell* tmp = graph->array[i]; tmp != NULL; tmp = tmp->nextCell){
+            incoming->inDegrees[tmp->value]++;
+        }
+    }
+    for (int i = 0; i<graph->numberVertices; i++){
+        incoming->capacities[i] = incoming->inDegrees[i];
+        incoming->predecessors[i] = incoming->inDegrees[i] > 0 ? malloc(sizeof(int)*incoming->inDegrees[i]) : NULL;
+        incoming->inDegrees[i] = 0;
+    }
+    for (int i = 0; i<graph->numberVertices; i++){
+        for (Cell* tmp = graph->array[i]; tmp != NULL; tmp = tmp->nextCell){
+            incoming->predecessors[tmp->value][incoming->inDegrees[tmp->value]++] = i;
+        }
+    }
+    graph->incoming = incoming;
+}
+
+
+/**
+ * @brief Function that gives the component of a vertex in a graph whose components are tracked.
+ *
+ * @param graph The graph.
+ * @param vertex The vertex.
+ *
+ * @return The representative of the component of the vertex.
+ */
+int componentOfVertex(Graph graph, int vertex){
+    return findRepresentative(graph.connectivity, vertex);
+}
+
+
+/**
+ * @brief Function that gives the number of connected components of a graph whose components are tracked.
+ *
+ * @param graph The graph.
+ *
+ * @return The number of components.
+ */
+int numberOfTrackedComponents(Graph graph){
+    return graph.connectivity->numberComponents;
+}
+
+
+/**
+ * @brief Returns the cell of the grid containing a point
+ */
+static int cellOf(int gridSize, double x, double y){
+    int cx = (int) (x*gridSize);
+    int cy = (int) (y*gridSize);
+    cx = cx < 0 ? 0 : (cx >= gridSize ? gridSize-1 : cx);
+    cy = cy < 0 ? 0 : (cy >= gridSize ? gridSize-1 : cy);
+    return cy*gridSize + cx;
+}
+
+
+/**
+ * @brief Function to bucket points of [0,1]x[0,1] in a grid of cells of size at least sigma.
+ *
+ * @param numVertices The number of points.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param sigma Minimal size of the cells.
+ *
+ * @return The grid. The number of cells is at most about numVertices.
+ */
+PointGrid createPointGrid(int numVertices, const double *xCoordinates, const double *yCoordinates, double sigma){
+    PointGrid grid;
+    /* cells of size 1/gridSize >= sigma, and not much more cells than points */
+    int maxGridSize = (int) sqrt(numVertices) + 1;
+    grid.gridSize = 1;
+    if (sigma > 0 && sigma < 1){
+        double size = floor(1.0/sigma);
+        grid.gridSize = size > maxGridSize ? maxGridSize : (int) size;
+    }
+    int numCells = grid.gridSize*grid.gridSize;
+    grid.cellStart = calloc(numCells+1, sizeof(int));
+    grid.points = malloc(sizeof(int)*(numVertices > 0 ? numVertices : 1));
+    grid.cellOfPoint = malloc(sizeof(int)*(numVertices > 0 ? numVertices : 1));
+    grid.xSorted = malloc(sizeof(double)*(numVertices > 0 ? numVertices : 1));
+    grid.ySorted = malloc(sizeof(double)*(numVertices > 0 ? numVertices : 1));
+    /* counting sort of the points by cell */
+    for (int i = 0; i<numVertices; i++){
+        grid.cellOfPoint[i] = cellOf(grid.gridSize, xCoordinates[i], yCoordinates[i]);
+        grid.cellStart[grid.cellOfPoint[i]+1]++;
+    }
+    for (int c = 0; c<numCells; c++){
+        grid.cellStart[c+1] += grid.cellStart[c];
+    }
+    int *next = malloc(sizeof(int)*numCells);
+    memcpy(next, grid.cellStart, sizeof(int)*numCells);
+    /* the coordinates are copied in the order of the cells, so that a cell is scanned contiguously */
+    for (int i = 0; i<numVertices; i++){
+        int k = next[grid.cellOfPoint[i]]++;
+        grid.points[k] = i;
+        grid.xSorted[k] = xCoordinates[i];
+        grid.ySorted[k] = yCoordinates[i];
+    }
+    free(next);
+    return grid;
+}
+
+
+/**
+ * @brief Function to free the memory used by a grid of points.
+ *
+ * @param grid Pointer on the grid to free.
+ */
+void freePointGrid(PointGrid *grid){
+    free(grid->cellStart);
+    free(grid->points);
+    free(grid->cellOfPoint);
+    free(grid->xSorted);
+    free(grid->ySorted);
+    grid->xSorted = NULL;
+    grid->ySorted = NULL;
+    grid->cellStart = NULL;
+    grid->points = NULL;
+    grid->cellOfPoint = NULL;
+    grid->gridSize = 0;
+}
+
+
+/**
+ * @brief Comparison of two integers for qsort
+ */
+static int compareVertices(const void *first, const void *second){
+    int a = *(const int*) first;
+    int b = *(const int*) second;
+    return (a > b) - (a < b);
+}
+
+
+/**
+ * @brief Function to compute the successors of a vertex with the procedure of createGraph.
+ *
+ * @param grid The grid of the points.
+ * @param vertex The vertex.
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param neighbors Array (of size at least the number of vertices) filled with the successors in increasing order.
+ *
+ * @return The number of successors.
+ *
+ * Only the points of the cell of the vertex and of the 8 neighboring cells are tested,
+ * with the same test as the all-pairs procedure, so the edges are exactly the same.
+ */
+int findNeighborsInGrid(PointGrid grid, int vertex, int directed, double sigma, const double *xCoordinates, const double *yCoordinates, int *neighbors){
+    int nbNeighbors = 0;
+    double x = xCoordinates[vertex];
+    double y = yCoordinates[vertex];
+    int cx = grid.cellOfPoint[vertex] % grid.gridSize;
+    int cy = grid.cellOfPoint[vertex] / grid.gridSize;
+    /* the cells of a row of the grid are contiguous in the array points */
+    int firstColumn = cx > 0 ? cx-1 : 0;
+    int lastColumn = cx+1 < grid.gridSize ? cx+1 : grid.gridSize-1;
+    for (int ny = cy-1; ny <= cy+1; ny++){
+        if (ny < 0 || ny >= grid.gridSize){
+            continue;
+        }
+        int begin = grid.cellStart[ny*grid.gridSize + firstColumn];
+        int end = grid.cellStart[ny*grid.gridSize + lastColumn + 1];
+        int first = nbNeighbors;
+        int count = pointsWithinDistance(x, y, grid.xSorted, grid.ySorted, begin, end, sigma, 0, neighbors + first);
+        /* the indices in the block are replaced in place by the vertices kept */
+        for (int m = 0; m < count; m++){
+            int k = neighbors[first + m];
+            if (grid.points[k] != vertex && (directed == 0 || y < grid.ySorted[k])){
+                neighbors[nbNeighbors++] = grid.points[k];
+            }
+        }
+    }
+    /* same order as the loop on all the vertices */
+    qsort(neighbors, nbNeighbors, sizeof(int), compareVertices);
+    return nbNeighbors;
+}
+
+
+/**
+ * @brief Function to create a graph with random points and without edges.
  *
  * @param numVertices The number of vertices in the graph.
  * @param sigma Parameter of the procedure to generate a random graph.
- * @param directedt The graph is undirected if directed==0, directed otherwise
+ * @param generator The generator of the points.
  *
- * @return A pointer to the new graph.
+ * @return The new graph.
  *
- * The elements of the array parents are set to -1.
- * The array of adjacency lists must be updated.
- * If the graph is a directed one, then there exist an edge from P1(x1,y1)
- * to P2(x2,y2) if and only if the euclidean distance between P1 and P2 is
- * less than sigma and y1<y2.
- * If the graph is a undirected one, then there exist an edge between P1(x1,y1)
- * and P2(x2,y2) if and only if the euclidean distance between P1 and P2 is
- * less than sigma.
+ * The points are drawn uniformly in [0,1]x[0,1] with the generator.
+ * The elements of the arrays parents and topological_ordering are set to -1,
+ * the start dates are set to -1.
  */
-Graph createGraph(int directed, int numVertices, double sigma) {
+Graph createGraphWithoutEdges(int numVertices, double sigma, RandomGenerator *generator) {
     Graph graph;
     graph.numberVertices = numVertices;
+    graph.capacity = numVertices;
+    graph.connectivity = NULL;
+    graph.incoming = NULL;
     graph.sigma = sigma;
     graph.array = malloc(sizeof(List*)*numVertices);
     graph.xCoordinates = malloc(sizeof(double)*numVertices);
@@ -73,46 +603,275 @@ Graph createGraph(int directed, int numVertices, double sigma) {
     graph.earliest_start = malloc(sizeof(double)*numVertices);
     graph.latest_start = malloc(sizeof(double)*numVertices);
     for (int i = 0; i<numVertices; i++){
-        graph.xCoordinates[i] = (rand() %1000001 ) /1000000.0;
-        graph.yCoordinates[i] = (rand() %1000001)/1000000.0;
+        graph.xCoordinates[i] = rngBounded(generator, 1000001)/1000000.0;
+        graph.yCoordinates[i] = rngBounded(generator, 1000001)/1000000.0;
         graph.parents[i] = -1;
         graph.topological_ordering[i] = -1;
         graph.earliest_start[i] = -1.00;
         graph.latest_start[i] = -1.00;
         graph.array[i] = newList();
     }
-    if (directed != 0){
+    return graph;
+}
 
-        for (int i = 0; i<numVertices; i++){
-            for (int j = 0; j<numVertices; j++){
-                double d;
-                d = distance(graph.xCoordinates[i], graph.yCoordinates[i], graph.xCoordinates[j], graph.yCoordinates[j]);
-                if (d < sigma && graph.yCoordinates[i] < graph.yCoordinates[j]
-                        && i!=j){
-                    addEdgeInGraph(graph,i,j);
-                }
-            }
+
+/**
+ * @brief Function to create a random graph with a specified number of vertices and parameter sigma.
+ *
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param directedt The graph is undirected if directed==0, directed otherwise
+ *
+ * @return A pointer to the new graph.
+ *
+ * The elements of the array parents are set to -1.
+ * The array of adjacency lists must be updated.
+ * If the graph is a directed one, then there exist an edge from P1(x1,y1)
+ * to P2(x2,y2) if and only if the euclidean distance between P1 and P2 is
+ * less than sigma and y1<y2.
+ * If the graph is a undirected one, then there exist an edge between P1(x1,y1)
+ * and P2(x2,y2) if and only if the euclidean distance between P1 and P2 is
+ * less than sigma.
+ */
+Graph createGraph(int directed, int numVertices, double sigma) {
+    return createGraphWithGenerator(directed, numVertices, sigma, rngDefault());
+}
+
+
+/**
+ * @brief Same as createGraph, with the points drawn from a given generator.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param generator The generator of the points.
+ *
+ * @return The new graph.
+ */
+Graph createGraphWithGenerator(int directed, int numVertices, double sigma, RandomGenerator *generator) {
+    Graph graph = createGraphWithoutEdges(numVertices, sigma, generator);
+    /* only the points of neighboring cells of a grid can be at distance less than sigma */
+    PointGrid grid = createPointGrid(numVertices, graph.xCoordinates, graph.yCoordinates, sigma);
+    int *neighbors = malloc(sizeof(int)*(numVertices > 0 ? numVertices : 1));
+    for (int i = 0; i<numVertices; i++){
+        int nbNeighbors = findNeighborsInGrid(grid, i, directed, sigma, graph.xCoordinates, graph.yCoordinates, neighbors);
+        for (int k = 0; k<nbNeighbors; k++){
+            addEdgeInGraph(graph,i,neighbors[k]);
         }
     }
-    else{
-        for (int i = 0; i<numVertices; i++){
-            for (int j = 0; j<numVertices; j++){
-                double d;
-                d = distance(graph.xCoordinates[i], graph.yCoordinates[i],
-                        graph.xCoordinates[j],
-                        graph.yCoordinates[j]);
-                if (d < sigma && i!=j){
-                    addEdgeInGraph(graph,i,j);
+    free(neighbors);
+    freePointGrid(&grid);
+    return graph;
+}
 
-                }
+
+/**
+ * @brief Argument of the threads of findEdgesInParallel
+ */
+typedef struct edgeTask{
+    PointGrid grid;
+    int numVertices;
+    int directed;
+    double sigma;
+    const double *xCoordinates;
+    const double *yCoordinates;
+    EdgeBuffer *buffer;
+} EdgeTask;
+
+/**
+ * @brief Thread function of findEdgesInParallel
+ */
+static void* findEdgesTask(void *argument){
+    EdgeTask *task = argument;
+    EdgeBuffer *buffer = task->buffer;
+    int *neighbors = malloc(sizeof(int)*(task->numVertices > 0 ? task->numVertices : 1));
+    for (int i = buffer->begin; i<buffer->end; i++){
+        int nbNeighbors = findNeighborsInGrid(task->grid, i, task->directed, task->sigma,
+                                              task->xCoordinates, task->yCoordinates, neighbors);
+        if (buffer->numberEdges + nbNeighbors > buffer->capacity){
+            while (buffer->numberEdges + nbNeighbors > buffer->capacity){
+                buffer->capacity *= 2;
             }
+            buffer->successors = realloc(buffer->successors, sizeof(int)*buffer->capacity);
         }
+        memcpy(buffer->successors + buffer->numberEdges, neighbors, sizeof(int)*nbNeighbors);
+        buffer->numberEdges += nbNeighbors;
+        buffer->degrees[i - buffer->begin] = nbNeighbors;
+    }
+    free(neighbors);
+    return NULL;
+}
+
 
+/**
+ * @brief Function to compute the successors of all the vertices with several threads.
+ *
+ * @param grid The grid of the points.
+ * @param numVertices The number of vertices.
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param nbThreads The number of threads.
+ *
+ * @return An array of nbThreads buffers, one for each range of consecutive vertices.
+ */
+EdgeBuffer* findEdgesInParallel(PointGrid grid, int numVertices, int directed, double sigma, const double *xCoordinates, const double *yCoordinates, int nbThreads){
+    if (nbThreads < 1){
+        nbThreads = 1;
+    }
+    /* the kernel is chosen before the threads use it */
+    if (distanceKernel < 0){
+        selectDistanceKernel(DISTANCE_KERNEL_AVX2);
+    }
+    EdgeBuffer *buffers = malloc(sizeof(EdgeBuffer)*nbThreads);
+    EdgeTask *tasks = malloc(sizeof(EdgeTask)*nbThreads);
+    pthread_t *threads = malloc(sizeof(pthread_t)*nbThreads);
+    int n = numVertices;
+    for (int t = 0; t < nbThreads; t++){
+        buffers[t].begin = (int) ((long) n * t / nbThreads);
+        buffers[t].end = (int) ((long) n * (t + 1) / nbThreads);
+        int size = buffers[t].end - buffers[t].begin;
+        buffers[t].degrees = malloc(sizeof(int)*(size > 0 ? size : 1));
+        buffers[t].capacity = 8L*(size > 0 ? size : 1);
+        buffers[t].successors = malloc(sizeof(int)*buffers[t].capacity);
+        buffers[t].numberEdges = 0;
+        tasks[t].grid = grid;
+        tasks[t].numVertices = numVertices;
+        tasks[t].directed = directed;
+        tasks[t].sigma = sigma;
+        tasks[t].xCoordinates = xCoordinates;
+        tasks[t].yCoordinates = yCoordinates;
+        tasks[t].buffer = &buffers[t];
+        /* the calling thread computes the last range */
+        if (t < nbThreads - 1){
+            pthread_create(&threads[t], NULL, findEdgesTask, &tasks[t]);
+        }
+    }
+    findEdgesTask(&tasks[nbThreads - 1]);
+    for (int t = 0; t < nbThreads - 1; t++){
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    free(tasks);
+    return buffers;
+}
+
+
+/**
+ * @brief Function to free the buffers returned by findEdgesInParallel.
+ *
+ * @param buffers The array of buffers.
+ * @param nbThreads The number of buffers.
+ */
+void freeEdgeBuffers(EdgeBuffer *buffers, int nbThreads){
+    for (int t = 0; t < nbThreads; t++){
+        free(buffers[t].degrees);
+        free(buffers[t].successors);
+    }
+    free(buffers);
+}
+
+
+/**
+ * @brief Argument of the threads of createGraphParallel
+ */
+typedef struct listTask{
+    Graph graph;
+    EdgeBuffer *buffer;
+} ListTask;
+
+/**
+ * @brief Thread function of createGraphParallel: builds the lists of the vertices of a buffer
+ */
+static void* buildListsTask(void *argument){
+    ListTask *task = argument;
+    EdgeBuffer *buffer = task->buffer;
+    long k = 0;
+    for (int i = buffer->begin; i<buffer->end; i++){
+        for (int d = 0; d<buffer->degrees[i - buffer->begin]; d++){
+            addEdgeInGraph(task->graph, i, buffer->successors[k++]);
+        }
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Same as createGraph, but the edges are computed with several threads.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param nbThreads The number of threads.
+ * @param generator The generator of the points.
+ *
+ * @return The new graph.
+ *
+ * Each thread then builds the lists of its own range of vertices, so the lists
+ * are built without lock and in the same order as in createGraph.
+ */
+Graph createGraphParallel(int directed, int numVertices, double sigma, int nbThreads, RandomGenerator *generator){
+    if (nbThreads < 1){
+        nbThreads = 1;
+    }
+    Graph graph = createGraphWithoutEdges(numVertices, sigma, generator);
+    PointGrid grid = createPointGrid(numVertices, graph.xCoordinates, graph.yCoordinates, sigma);
+    EdgeBuffer *buffers = findEdgesInParallel(grid, numVertices, directed, sigma, graph.xCoordinates, graph.yCoordinates, nbThreads);
+    freePointGrid(&grid);
+    ListTask *tasks = malloc(sizeof(ListTask)*nbThreads);
+    pthread_t *threads = malloc(sizeof(pthread_t)*nbThreads);
+    for (int t = 0; t < nbThreads; t++){
+        tasks[t].graph = graph;
+        tasks[t].buffer = &buffers[t];
+        if (t < nbThreads - 1){
+            pthread_create(&threads[t], NULL, buildListsTask, &tasks[t]);
+        }
     }
+    buildListsTask(&tasks[nbThreads - 1]);
+    for (int t = 0; t < nbThreads - 1; t++){
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    free(tasks);
+    freeEdgeBuffers(buffers, nbThreads);
     return graph;
 }
 
 
+/**
+ * @brief Function to free the memory used by a graph.
+ *
+ * @param graph The graph to free.
+ */
+void freeGraph(Graph graph) {
+    for (int i = 0; i<graph.numberVertices; i++){
+        freeList(graph.array[i]);
+    }
+    free(graph.array);
+    free(graph.xCoordinates);
+    free(graph.yCoordinates);
+    free(graph.parents);
+    free(graph.topological_ordering);
+    free(graph.earliest_start);
+    free(graph.latest_start);
+    if (graph.connectivity){
+        free(graph.connectivity->representatives);
+        free(graph.connectivity->ranks);
+        free(graph.connectivity);
+    }
+    if (graph.incoming){
+        for (int i = 0; i<graph.numberVertices; i++){
+            free(graph.incoming->predecessors[i]);
+        }
+        free(graph.incoming->inDegrees);
+        free(graph.incoming->capacities);
+        free(graph.incoming->predecessors);
+        free(graph.incoming);
+    }
+}
+
+
 /**
  * @brief Function to print the graph in the console.
  *
@@ -160,6 +919,141 @@ void printConsoleGraph(Graph graph){
     return;
 }
 
+/**
+ * @brief Output buffer of the svg writer, written to the file by large blocks
+ */
+typedef struct svgWriter{
+    FILE *file;
+    char *buffer;
+    size_t used;
+    size_t capacity;
+} SvgWriter;
+
+#define SVG_BUFFER_SIZE (1 << 16)
+#define DRAW_DECIMATION_THRESHOLD 20000
+
+/**
+ * @brief Makes room for size bytes: writes the buffer to the file, or grows it if there is no file
+ */
+static void svgReserve(SvgWriter *writer, size_t size){
+    if (writer->used + size <= writer->capacity){
+        return;
+    }
+    if (writer->file != NULL){
+        fwrite(writer->buffer, 1, writer->used, writer->file);
+        writer->used = 0;
+    }
+    if (writer->used + size > writer->capacity){
+        while (writer->used + size > writer->capacity){
+            writer->capacity *= 2;
+        }
+        writer->buffer = realloc(writer->buffer, writer->capacity);
+    }
+}
+
+/**
+ * @brief Appends a string
+ */
+static void svgWrite(SvgWriter *writer, const char *text){
+    size_t length = strlen(text);
+    svgReserve(writer, length);
+    memcpy(writer->buffer + writer->used, text, length);
+    writer->used += length;
+}
+
+/**
+ * @brief Appends a command of a path and a point, for instance "M12 34"
+ */
+static void svgWritePoint(SvgWriter *writer, char command, int x, int y){
+    svgReserve(writer, 32);
+    char *p = writer->buffer + writer->used;
+    *p++ = command;
+    int values[2] = {x, y};
+    for (int v = 0; v < 2; v++){
+        if (v == 1){
+            *p++ = ' ';
+        }
+        unsigned int value = values[v] < 0 ? -(unsigned int) values[v] : (unsigned int) values[v];
+        if (values[v] < 0){
+            *p++ = '-';
+        }
+        char digits[12];
+        int nbDigits = 0;
+        do {
+            digits[nbDigits++] = (char) ('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (nbDigits > 0){
+            *p++ = digits[--nbDigits];
+        }
+    }
+    writer->used = p - writer->buffer;
+}
+
+/**
+ * @brief Appends the content of a buffer of memory and empties it
+ */
+static void svgWriteBuffer(SvgWriter *writer, SvgWriter *memory){
+    svgReserve(writer, memory->used);
+    memcpy(writer->buffer + writer->used, memory->buffer, memory->used);
+    writer->used += memory->used;
+    memory->used = 0;
+}
+
+/**
+ * @brief Returns the coordinate in the svg file of a coordinate in [0,1]
+ */
+static int pixelOf(double coordinate){
+    return (int) (600*coordinate)+100;
+}
+
+/**
+ * @brief Moves a coordinate of the svg file to the center of its cell of cellSize pixels
+ */
+static int snapToCell(int pixel, int cellSize){
+    if (cellSize <= 1){
+        return pixel;
+    }
+    return (pixel / cellSize) * cellSize + cellSize / 2;
+}
+
+/**
+ * @brief Appends an edge to a path: a segment and, if directed, the two sides of the arrowhead
+ */
+static void svgWriteEdge(SvgWriter *writer, int x1, int y1, int x2, int y2, int directed){
+    svgWritePoint(writer, 'M', x1, y1);
+    svgWritePoint(writer, 'L', x2, y2);
+    if (directed){
+        double dx = x2 - x1, dy = y2 - y1;
+        double length = sqrt(dx*dx + dy*dy);
+        if (length > 0){
+            dx /= length;
+            dy /= length;
+            svgWritePoint(writer, 'M', (int) lround(x2 - 9*dx - 3*dy), (int) lround(y2 - 9*dy + 3*dx));
+            svgWritePoint(writer, 'L', x2, y2);
+            svgWritePoint(writer, 'L', (int) lround(x2 - 9*dx + 3*dy), (int) lround(y2 - 9*dy - 3*dx));
+        }
+    }
+}
+
+/**
+ * @brief Inserts a segment between two pixels in a hash set, returns 0 if it was already in the set
+ */
+static int insertSegment(uint64_t *set, size_t mask, int x1, int y1, int x2, int y2){
+    uint64_t key = ((uint64_t) (x1 & 0xffff) << 48) | ((uint64_t) (y1 & 0xffff) << 32)
+                 | ((uint64_t) (x2 & 0xffff) << 16) | (uint64_t) (y2 & 0xffff);
+    size_t slot = (size_t) ((key * 0x9e3779b97f4a7c15ULL) >> 20) & mask;
+    while (set[slot] != UINT64_MAX){
+        if (set[slot] == key){
+            return 0;
+        }
+        slot = (slot + 1) & mask;
+    }
+    set[slot] = key;
+    return 1;
+}
+
+
 /**
  * @brief Function to draw the graph in a svg file.
  *
@@ -167,11 +1061,28 @@ void printConsoleGraph(Graph graph){
  * @param filename Name of the svg file.
  * @param type if 0, draws only the graph, if 1 draws the covering tree, if 2 draws both graph and spanning tree, if 3 draws the graph with topological order and dates
  * @param directed If directed==0, the graph is undirected and lines are drawn. Otherwise, arrows are drawn.
+ *
+ * The level of detail is reduced for the graphs of more than 20000 vertices.
  */
-
-
 void drawGraph(Graph graph, char* filename, int type, int directed){
+    drawGraphWithDetail(graph, filename, type, directed, graph.numberVertices > DRAW_DECIMATION_THRESHOLD ? 2 : 0);
+}
 
+
+/**
+ * @brief Same as drawGraph, with the level of detail chosen by the caller.
+ *
+ * @param graph The graph to print.
+ * @param filename Name of the svg file.
+ * @param type Same as in drawGraph.
+ * @param directed Same as in drawGraph.
+ * @param decimate If decimate>0, the points are moved to the center of their cell of decimate x decimate
+ * pixels, then a vertex whose cell is already drawn is skipped, and so is an edge between two cells
+ * already linked or inside a single cell. The edges of the spanning tree are never skipped.
+ *
+ * @return The number of edges drawn.
+ */
+int drawGraphWithDetail(Graph graph, char* filename, int type, int directed, int decimate){
     FILE *fptr;
     fptr = fopen(filename, "w");
     if (fptr == NULL)
@@ -179,85 +1090,113 @@ void drawGraph(Graph graph, char* filename, int type, int directed){
         printf("Error opening file %s\n",filename);
         exit(-1);
     }
-    fprintf(fptr, "<?xml version=\"1.0\" standalone=\"no\"?>\n");
-    fprintf(fptr, "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"\n");
-    fprintf(fptr, "  \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n");
-    fprintf(fptr, "<svg width=\"800\" height=\"800\"\n");
-    fprintf(fptr, "     xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">\n");
-    fprintf(fptr, "<rect x=\"0\" y=\"0\" width=\"100%%\" height=\"100%%\" fill=\"white\" />\n");
-
-    fprintf(fptr, "<defs>\n");
-    fprintf(fptr, "<marker id=\"arrow\" markerWidth=\"10\" markerHeight=\"10\" refX=\"10\" refY=\"3\" orient=\"auto\">\n");
-    fprintf(fptr, "<path d=\"M0,0 L0,6 L9,3 z\"/>\n");
-    fprintf(fptr, "</marker>\n");
-    fprintf(fptr, "</defs>\n");
+    SvgWriter writer = {fptr, malloc(SVG_BUFFER_SIZE), 0, SVG_BUFFER_SIZE};
+    /* the edges of the tree are drawn on top of the others, so they are kept in memory until the end */
+    SvgWriter tree = {NULL, malloc(SVG_BUFFER_SIZE), 0, SVG_BUFFER_SIZE};
+    svgWrite(&writer, "<?xml version=\"1.0\" standalone=\"no\"?>\n"
+                      "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"\n"
+                      "  \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n"
+                      "<svg width=\"800\" height=\"800\"\n"
+                      "     xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\">\n"
+                      "<rect x=\"0\" y=\"0\" width=\"100%\" height=\"100%\" fill=\"white\" />\n");
 
+    /* a vertex is a segment of length 0 with round caps */
+    int cells = decimate > 0 ? 800/decimate + 1 : 0;
+    unsigned char *drawnCells = decimate > 0 ? calloc(cells*cells, 1) : NULL;
+    svgWrite(&writer, "<path fill=\"none\" stroke=\"blue\" stroke-width=\"6\" stroke-linecap=\"round\" d=\"");
     for(int i=0;i<graph.numberVertices;i++){
-        int x1 = (int) (600*graph.xCoordinates[i])+100;
-        int y1 = (int) (600*graph.yCoordinates[i])+100;
-        fprintf(fptr, "<circle cx=\"%d\" cy=\"%d\" r=\"%d\" fill=\"blue\" />\n", x1, y1, 3);
+        int x = snapToCell(pixelOf(graph.xCoordinates[i]), decimate);
+        int y = snapToCell(pixelOf(graph.yCoordinates[i]), decimate);
+        if (decimate > 0 && x >= 0 && x < 800 && y >= 0 && y < 800){
+            int cell = (y/decimate)*cells + x/decimate;
+            if (drawnCells[cell]){
+                continue;
+            }
+            drawnCells[cell] = 1;
+        }
+        svgWritePoint(&writer, 'M', x, y);
+        svgWrite(&writer, "h0");
     }
+    svgWrite(&writer, "\"/>\n");
+    free(drawnCells);
 
-
+    uint64_t *segments = NULL;
+    size_t mask = 0;
+    if (decimate > 0){
+        long numEdges = 0;
+        for(int i=0;i<graph.numberVertices;i++){
+            for (Cell* tmp = graph.array[i]; tmp != NULL; tmp = tmp->nextCell){
+                numEdges++;
+            }
+        }
+        size_t size = 16;
+        while (size < 2*(size_t) numEdges){
+            size *= 2;
+        }
+        segments = malloc(sizeof(uint64_t)*size);
+        memset(segments, 0xff, sizeof(uint64_t)*size);
+        mask = size - 1;
+    }
+    int drawn = 0;
+    if (type != 1){
+        svgWrite(&writer, "<path fill=\"none\" stroke=\"darkgray\" d=\"");
+    }
+    /* each edge is read once in the lists, an undirected edge is drawn from its smallest vertex */
     for(int i=0;i<graph.numberVertices;i++){
-        int x1 = (int) (600*graph.xCoordinates[i])+100;
-        int y1 = (int) (600*graph.yCoordinates[i])+100;
-        fprintf(fptr, "<circle cx=\"%d\" cy=\"%d\" r=\"%d\" fill=\"blue\" />\n", x1, y1, 3);
-        for(int j=i+1;j<graph.numberVertices;j++)
-            if(distance(graph.xCoordinates[i],graph.yCoordinates[i],
-                        graph.xCoordinates[j],graph.yCoordinates[j]) <= graph.sigma){
-                int x2 = (int) (600*graph.xCoordinates[j])+100;
-                int y2 = (int) (600*graph.yCoordinates[j])+100;
-                int xorigin, yorigin, xdestination, ydestination;
-                if(graph.yCoordinates[i]<graph.yCoordinates[j]){
-                    xorigin = x1; yorigin = y1;
-                    xdestination = x2; ydestination = y2;
-                }
-                else{
-                    xorigin = x2; yorigin = y2;
-                    xdestination = x1; ydestination = y1;
+        for (Cell* tmp = graph.array[i]; tmp != NULL; tmp = tmp->nextCell){
+            int j = tmp->value;
+            if (directed==0 && j<i){
+                continue;
+            }
+            int inTree = graph.parents[i]==j || graph.parents[j]==i;
+            if (type == 1 && !inTree){
+                continue;
+            }
+            int treeEdge = (type == 1 || type == 2) && inTree;
+            int xorigin = snapToCell(pixelOf(graph.xCoordinates[i]), decimate);
+            int yorigin = snapToCell(pixelOf(graph.yCoordinates[i]), decimate);
+            int xdestination = snapToCell(pixelOf(graph.xCoordinates[j]), decimate);
+            int ydestination = snapToCell(pixelOf(graph.yCoordinates[j]), decimate);
+            /* the tree has less edges than vertices, so it is drawn in full over the decimated graph */
+            if (decimate > 0 && !treeEdge){
+                if (xorigin == xdestination && yorigin == ydestination){
+                    continue;
                 }
-                char arrow[30];
-                if(directed==1)
-                    strcpy(arrow,"marker-end=\"url(#arrow)\"");
-                else
-                    strcpy(arrow," ");
-
-                switch(type){
-                    case 0:
-                    case 3:
-                        fprintf(fptr, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"\n",
-                                xorigin, yorigin, xdestination, ydestination);
-                        fprintf(fptr, "      style=\"stroke: darkgray;\" %s />\n",arrow);
-                        break;
-                    case 1:
-                        if(graph.parents[i]==j || graph.parents[j]==i){
-                            fprintf(fptr, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"\n",
-                                    xorigin, yorigin, xdestination, ydestination);
-                            fprintf(fptr, "      style=\"stroke: red;\" %s />\n",arrow);
-                        }
-                        break;
-                    case 2:
-                        fprintf(fptr, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\"\n",
-                                xorigin, yorigin, xdestination, ydestination);
-                        if(graph.parents[i]==j || graph.parents[j]==i)
-                            fprintf(fptr, "      style=\"stroke: red;\" %s />\n",arrow);
-                        else
-                            fprintf(fptr, "      style=\"stroke: darkgray;\" %s />\n",arrow);
-                        break;
+                if (!insertSegment(segments, mask, xorigin, yorigin, xdestination, ydestination)){
+                    continue;
                 }
             }
+            svgWriteEdge(treeEdge ? &tree : &writer,
+                         xorigin, yorigin, xdestination, ydestination, directed);
+            drawn++;
+        }
+    }
+    free(segments);
+    if (type != 1){
+        svgWrite(&writer, "\"/>\n");
     }
+    if (type == 1 || type == 2){
+        svgWrite(&writer, "<path fill=\"none\" stroke=\"red\" d=\"");
+        svgWriteBuffer(&writer, &tree);
+        svgWrite(&writer, "\"/>\n");
+    }
+    free(tree.buffer);
+
     if(type==3){
+        char text[200];
         for(int i=0;i<graph.numberVertices;i++){
             int vertex = graph.topological_ordering[i];
-            int x1 = (int) (600*graph.xCoordinates[vertex])+100;
-            int y1 = (int) (600*graph.yCoordinates[vertex])+100;
-            fprintf(fptr, "<text x=\"%d\" y=\"%d\" font-family=\"Verdana\" font-size=\"10\"> P%d:[%d,%.3lf,%.3lf]  </text>",x1+10,y1,vertex,i,graph.earliest_start[vertex],graph.latest_start[vertex]);
+            snprintf(text, sizeof(text), "<text x=\"%d\" y=\"%d\" font-family=\"Verdana\" font-size=\"10\"> P%d:[%d,%.3lf,%.3lf]  </text>",
+                     pixelOf(graph.xCoordinates[vertex])+10, pixelOf(graph.yCoordinates[vertex]), vertex, i,
+                     graph.earliest_start[vertex], graph.latest_start[vertex]);
+            svgWrite(&writer, text);
         }
     }
-    fprintf(fptr, "</svg>\n");
+    svgWrite(&writer, "</svg>\n");
+    fwrite(writer.buffer, 1, writer.used, fptr);
+    free(writer.buffer);
     fclose(fptr);
+    return drawn;
 }
 
 /**
@@ -10,16 +10,47 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "../list/list.h"
+#include "../utils/rng.h"
 
 
 
 
+/**
+ * @brief This struct is a union-find structure on the vertices of a graph.
+ *
+ * The vertices of a component form a tree, whose root is the representative
+ * of the component. The trees are merged by rank, and the paths are compressed
+ * when a root is searched, so the operations take an almost constant amortized time.
+ */
+typedef struct Connectivity {
+    int *representatives;   /** array of the parent of each vertex in its tree, a root is its own parent. */
+    int *ranks;   /** array of the rank of each root (an upper bound of the height of its tree). */
+    int numberComponents;   /** number of trees. */
+} Connectivity;
+
+
+/**
+ * @brief This struct is an index of the incoming edges of a graph.
+ *
+ * The predecessors of the vertex v are predecessors[v][0], ..., predecessors[v][inDegrees[v]-1]:
+ * the origins of the edges present when the index is built in increasing order, then the
+ * origins of the edges added later in the order of the additions. The array of a vertex
+ * grows geometrically, so adding an edge takes a constant amortized time.
+ */
+typedef struct IncomingEdges {
+    int *inDegrees;   /** array of the number of predecessors of each vertex. */
+    int *capacities;   /** array of the number of predecessors the array of each vertex can hold. */
+    int **predecessors;   /** array of the arrays of predecessors of each vertex. */
+} IncomingEdges;
+
+
 /**
  * @brief This struct represents the graph using an array of adjacency lists.
  *
  */
 typedef struct Graph {
     int numberVertices;   /** The number of vertices in the graph. */
+    int capacity;   /** The number of vertices the arrays can hold. */
     List *array;     /** Array of adjacency lists. A null pointer means an empty list*/
 
     double *xCoordinates;  /** array of the x coordinates of the points of each vertex */
@@ -33,9 +64,29 @@ typedef struct Graph {
     double *earliest_start; /** array to store the earliest start of each node. */
     double *latest_start; /** array to store the latest start of each node. */
 
+    Connectivity *connectivity; /** components maintained when edges and vertices are added, NULL if they are not tracked. */
+    IncomingEdges *incoming; /** predecessors maintained when edges and vertices are added, NULL if they are not tracked. */
+
 } Graph;
 
 
+/**
+ * @brief This struct buckets the points of a graph in a uniform grid of cells.
+ *
+ * The points of the cell c are points[cellStart[c]], ..., points[cellStart[c+1]-1].
+ * The cells are at least as large as sigma, so two points at distance less than
+ * sigma are in the same cell or in neighboring cells.
+ */
+typedef struct PointGrid {
+    int gridSize;   /** Number of cells in each dimension. */
+    int *cellStart;   /** array of gridSize*gridSize+1 indices of the first point of each cell in points. */
+    int *points;   /** array of the vertices sorted by cell. */
+    int *cellOfPoint;   /** array of the cell of each vertex. */
+    double *xSorted;   /** x coordinates of the points in the order of the array points. */
+    double *ySorted;   /** y coordinates of the points in the order of the array points. */
+} PointGrid;
+
+
 /**
  * @brief Computes the Euclidean distance between two points.
  *
@@ -47,6 +98,49 @@ typedef struct Graph {
  */
 double distance(double x1, double y1, double x2, double y2);
 
+/**
+ * @brief Kernels of the function pointsWithinDistance.
+ */
+typedef enum distanceKernel {
+    DISTANCE_KERNEL_SCALAR = 0, /** portable loop */
+    DISTANCE_KERNEL_SSE2, /** 2 points per step with SSE2 */
+    DISTANCE_KERNEL_AVX2 /** 4 points per step with AVX2 */
+} DistanceKernel;
+
+/**
+ * @brief Function to choose the kernel of pointsWithinDistance.
+ *
+ * @param kernel The requested kernel.
+ *
+ * @return The kernel that is used: the requested one if the processor supports it,
+ * the best supported one below it otherwise.
+ * By default, the best kernel supported by the processor is used.
+ */
+DistanceKernel selectDistanceKernel(DistanceKernel kernel);
+
+/**
+ * @brief Function to find the points of a block that are close to a point.
+ *
+ * @param x x coordinate of the point.
+ * @param y y coordinate of the point.
+ * @param xCoordinates The x coordinates of the points of the block.
+ * @param yCoordinates The y coordinates of the points of the block.
+ * @param begin Index of the first point of the block.
+ * @param end Index after the last point of the block.
+ * @param sigma The maximal distance.
+ * @param inclusive If inclusive==0, the distance must be less than sigma, otherwise less or equal.
+ * @param indices Array (of size at least end-begin) filled with the indices of the close points in increasing order.
+ *
+ * @return The number of close points.
+ *
+ * The squared distances are compared with sigma^2 several points at a time, and the
+ * rare points whose squared distance is within rounding errors of sigma^2 are checked
+ * with distance(), so the result is exactly the one of a loop testing distance().
+ */
+int pointsWithinDistance(double x, double y, const double *xCoordinates, const double *yCoordinates,
+                         int begin, int end, double sigma, int inclusive, int *indices);
+
+
 /**
  * @brief Function to add an oriented edge in a graph.
  *
@@ -54,10 +148,164 @@ double distance(double x1, double y1, double x2, double y2);
  * @param destination Destination vrtex of the edge.
  * @param graph The graph in which the edge is added.
  *
- * Only the array of adjacency lists is updated.
+ * Only the array of adjacency lists is updated, and the components and the predecessors if they are tracked.
  */
 void addEdgeInGraph(Graph graph, int origin, int destination);
 
+/**
+ * @brief Function to add a vertex in a graph, with its edges to the close points.
+ *
+ * @param graph Pointer on the graph in which the vertex is added.
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param x x coordinate of the point of the vertex.
+ * @param y y coordinate of the point of the vertex.
+ *
+ * @return The new vertex, numbered graph->numberVertices-1.
+ *
+ * The edges are the ones of the procedure of createGraph, so adding the points one by one
+ * gives the same edges as creating the graph with all of them. The close points are
+ * searched among all the points. The arrays grow geometrically, so the pointers
+ * of graph may change. The parents and the topological ordering of the vertex are set
+ * to -1, as its start dates.
+ */
+int addVertexInGraph(Graph *graph, int directed, double x, double y);
+
+/**
+ * @brief Function to maintain the connected components of a graph while it grows.
+ *
+ * @param graph Pointer on the graph.
+ *
+ * The components of the current edges are computed, then they are updated by addEdgeInGraph
+ * and addVertexInGraph. The direction of the edges is ignored, so the components of a directed
+ * graph are its weakly connected components. Nothing is done if the components are already tracked.
+ */
+void trackConnectivity(Graph *graph);
+
+/**
+ * @brief Function that gives the component of a vertex in a graph whose components are tracked.
+ *
+ * @param graph The graph.
+ * @param vertex The vertex.
+ *
+ * @return The representative of the component of the vertex: two vertices are connected
+ * if and only if they have the same representative. The representative of a component
+ * may change when edges are added.
+ */
+int componentOfVertex(Graph graph, int vertex);
+
+/**
+ * @brief Function that gives the number of connected components of a graph whose components are tracked.
+ *
+ * @param graph The graph.
+ *
+ * @return The number of components, without any traversal of the graph.
+ */
+int numberOfTrackedComponents(Graph graph);
+
+/**
+ * @brief Function to maintain the predecessors of the vertices of a graph while it grows.
+ *
+ * @param graph Pointer on the graph.
+ *
+ * The index of the incoming edges is built from the lists (the in-degrees are counted, then the
+ * arrays of exactly this size are filled), then it is updated by addEdgeInGraph and addVertexInGraph.
+ * Nothing is done if the predecessors are already tracked.
+ */
+void trackIncomingEdges(Graph *graph);
+
+
+/**
+ * @brief Function to bucket points of [0,1]x[0,1] in a grid of cells of size at least sigma.
+ *
+ * @param numVertices The number of points.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param sigma Minimal size of the cells.
+ *
+ * @return The grid. The number of cells is at most about numVertices.
+ */
+PointGrid createPointGrid(int numVertices, const double *xCoordinates, const double *yCoordinates, double sigma);
+
+/**
+ * @brief Function to free the memory used by a grid of points.
+ *
+ * @param grid Pointer on the grid to free.
+ */
+void freePointGrid(PointGrid *grid);
+
+/**
+ * @brief Function to compute the successors of a vertex with the procedure of createGraph.
+ *
+ * @param grid The grid of the points.
+ * @param vertex The vertex.
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param neighbors Array (of size at least the number of vertices) filled with the successors in increasing order.
+ *
+ * @return The number of successors.
+ *
+ * Only the points of the cell of the vertex and of the 8 neighboring cells are tested,
+ * with the same test as the all-pairs procedure, so the edges are exactly the same.
+ */
+int findNeighborsInGrid(PointGrid grid, int vertex, int directed, double sigma, const double *xCoordinates, const double *yCoordinates, int *neighbors);
+
+/**
+ * @brief Edges found by a thread for a range of vertices.
+ */
+typedef struct EdgeBuffer {
+    int begin;   /** first vertex of the range. */
+    int end;   /** vertex after the last vertex of the range. */
+    int *degrees;   /** array of the number of successors of each vertex of the range. */
+    int *successors;   /** array of the successors of the vertices of the range, vertex after vertex. */
+    long numberEdges;   /** number of edges in the array successors. */
+    long capacity;   /** size of the array successors. */
+} EdgeBuffer;
+
+/**
+ * @brief Function to compute the successors of all the vertices with several threads.
+ *
+ * @param grid The grid of the points.
+ * @param numVertices The number of vertices.
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param nbThreads The number of threads.
+ *
+ * @return An array of nbThreads buffers, the buffer t contains the successors (given by
+ * findNeighborsInGrid) of the t-th range of consecutive vertices.
+ *
+ * Each thread writes only in its own buffer, so no lock is needed, and the buffers
+ * only depend on the coordinates, so the result does not depend on the scheduling.
+ */
+EdgeBuffer* findEdgesInParallel(PointGrid grid, int numVertices, int directed, double sigma, const double *xCoordinates, const double *yCoordinates, int nbThreads);
+
+/**
+ * @brief Function to free the buffers returned by findEdgesInParallel.
+ *
+ * @param buffers The array of buffers.
+ * @param nbThreads The number of buffers.
+ */
+void freeEdgeBuffers(EdgeBuffer *buffers, int nbThreads);
+
+
+/**
+ * @brief Function to create a graph with random points and without edges.
+ *
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param generator The generator of the points.
+ *
+ * @return The new graph.
+ *
+ * The points are drawn uniformly in [0,1]x[0,1] with the generator.
+ * The elements of the arrays parents and topological_ordering are set to -1,
+ * the start dates are set to -1.
+ */
+Graph createGraphWithoutEdges(int numVertices, double sigma, RandomGenerator *generator);
+
 
 /**
  * @brief Function to create a random graph with a specified number of vertices and parameter sigma.
@@ -73,6 +321,43 @@ void addEdgeInGraph(Graph graph, int origin, int destination);
  */
 Graph createGraph(int directed, int numVertices, double sigma);
 
+/**
+ * @brief Same as createGraph, with the points drawn from a given generator.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param generator The generator of the points. createGraph uses the shared generator rngDefault().
+ *
+ * @return The new graph, which only depends on the state of the generator.
+ */
+Graph createGraphWithGenerator(int directed, int numVertices, double sigma, RandomGenerator *generator);
+
+/**
+ * @brief Same as createGraph, but the edges are computed with several threads.
+ *
+ * @param directed The graph is undirected if directed==0, directed otherwise
+ * @param numVertices The number of vertices in the graph.
+ * @param sigma Parameter of the procedure to generate a random graph.
+ * @param nbThreads The number of threads.
+ * @param generator The generator of the points.
+ *
+ * @return The new graph.
+ *
+ * The points are drawn by the calling thread, so from the same state of the generator
+ * the graph is exactly the one of createGraphWithGenerator (same lists in the same order),
+ * whatever the number of threads.
+ */
+Graph createGraphParallel(int directed, int numVertices, double sigma, int nbThreads, RandomGenerator *generator);
+
+
+/**
+ * @brief Function to free the memory used by a graph.
+ *
+ * @param graph The graph to free.
+ */
+void freeGraph(Graph graph);
+
 
 /**
  * @brief Function to print the graph in the console.
@@ -89,10 +374,29 @@ void printConsoleGraph(Graph graph);
  * @param filename Name of the svg file.
  * @param type if 0, draws only the graph, if 1 draws the covering tree, if 2 draws both graph and spanning tree, if 3 draws the graph with topological order and dates
  * @param directed If directed==0, the graph is undirected and lines are drawn. Otherwise, arrows are drawn.
+ *
+ * Each edge of the lists is read once, and the edges of a color are written in a single path.
+ * For the graphs of more than 20000 vertices, the level of detail is reduced to cells of 2x2 pixels (see drawGraphWithDetail).
  */
-
 void drawGraph(Graph graph, char* filename, int type, int directed);
 
+/**
+ * @brief Same as drawGraph, with the level of detail chosen by the caller.
+ *
+ * @param graph The graph to print.
+ * @param filename Name of the svg file.
+ * @param type Same as in drawGraph.
+ * @param directed Same as in drawGraph.
+ * @param decimate If decimate>0, the points are moved to the center of their cell of decimate x decimate
+ * pixels, then a vertex whose cell is already drawn is skipped, and so is an edge between two cells
+ * already linked or inside a single cell, so the size of the file is bounded by the number of cells
+ * rather than by the number of edges. The edges of the spanning tree are never skipped, so that
+ * types 1 and 2 draw the same tree. If decimate==0, everything is drawn.
+ *
+ * @return The number of edges drawn.
+ */
+int drawGraphWithDetail(Graph graph, char* filename, int type, int directed, int decimate);
+
 /**
  * @brief Function that performs a depth first search from a vertex.
  *
@@ -0,0 +1,298 @@
+/**
+ * @file graphfile.c
+ *
+ * @brief This file implements the binary file format of graphs.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "graphfile.h"
+
+#define GRAPH_FILE_MAGIC "CSRGRAPH"
+#define GRAPH_FILE_VERSION 2
+#define GRAPH_FILE_BYTE_ORDER 0x01020304
+
+/**
+ * @brief Sections of a graph file, in the order of the file
+ */
+enum {
+    SECTION_X, SECTION_Y, SECTION_OFFSETS, SECTION_TARGETS, SECTION_WEIGHTS,
+    SECTION_PARENTS, SECTION_ORDERING, SECTION_EARLIEST, SECTION_LATEST, NUMBER_OF_SECTIONS
+};
+
+
+/**
+ * @brief Rounds a size up to a multiple of 8
+ */
+static size_t alignSize(size_t size){
+    return (size + 7) & ~(size_t) 7;
+}
+
+
+/**
+ * @brief Computes the position of each section in a file (0 for the absent sections),
+ * returns the size of the file
+ */
+static size_t graphFileLayout(const GraphFileHeader *header, size_t positions[NUMBER_OF_SECTIONS]){
+    size_t n = header->numberVertices;
+    size_t m = header->numberEdges;
+    size_t sizes[NUMBER_OF_SECTIONS] = {
+        sizeof(double)*n, sizeof(double)*n, sizeof(int)*(n+1), sizeof(int)*m,
+        (header->sections & GRAPH_FILE_WEIGHTS) ? (size_t) header->weightSize*m : 0,
+        (header->sections & GRAPH_FILE_PARENTS) ? sizeof(int)*n : 0,
+        (header->sections & GRAPH_FILE_TOPOLOGICAL_ORDERING) ? sizeof(int)*n : 0,
+        (header->sections & GRAPH_FILE_START_DATES) ? sizeof(double)*n : 0,
+        (header->sections & GRAPH_FILE_START_DATES) ? sizeof(double)*n : 0
+    };
+    size_t position = alignSize(sizeof(GraphFileHeader));
+    for (int s = 0; s < NUMBER_OF_SECTIONS; s++){
+        positions[s] = sizes[s] > 0 ? position : 0;
+        position += alignSize(sizes[s]);
+    }
+    return position;
+}
+
+
+/**
+ * @brief Writes size bytes followed by zeros up to a multiple of 8, returns 1 on success
+ */
+static int writeSection(FILE *file, const void *data, size_t size){
+    static const char padding[8] = {0};
+    if (size > 0 && fwrite(data, 1, size, file) != size){
+        return 0;
+    }
+    size_t rest = alignSize(size) - size;
+    return rest == 0 || fwrite(padding, 1, rest, file) == rest;
+}
+
+
+/**
+ * @brief Function to write a graph in CSR format in a binary file.
+ *
+ * @param filename The name of the file.
+ * @param graph The graph. Its weights are written if graph.weights is not NULL.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param sigma Parameter sigma of the graph.
+ * @param earliestStart The earliest start dates, or NULL.
+ * @param latestStart The latest start dates, or NULL.
+ * @param sections The optional sections to write among GRAPH_FILE_PARENTS and GRAPH_FILE_TOPOLOGICAL_ORDERING.
+ *
+ * @return 1 if the file is written, 0 otherwise.
+ */
+int writeCSRGraphFile(const char *filename, CSRGraph graph, const double *xCoordinates, const double *yCoordinates,
+                      double sigma, const double *earliestStart, const double *latestStart, uint32_t sections){
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.sections = sections & (GRAPH_FILE_PARENTS | GRAPH_FILE_TOPOLOGICAL_ORDERING);
+    if (graph.weights != NULL){
+        header.sections |= GRAPH_FILE_WEIGHTS;
+        header.weightSize = sizeof(EdgeWeight);
+    }
+    if (earliestStart != NULL && latestStart != NULL){
+        header.sections |= GRAPH_FILE_START_DATES;
+    }
+    header.numberVertices = graph.numberVertices;
+    header.numberEdges = graph.numberEdges;
+    header.sigma = sigma;
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL){
+        printf("Error opening file %s\n", filename);
+        return 0;
+    }
+    size_t n = graph.numberVertices;
+    size_t m = graph.numberEdges;
+    int ok = writeSection(file, &header, sizeof(header));
+    ok = ok && writeSection(file, xCoordinates, sizeof(double)*n);
+    ok = ok && writeSection(file, yCoordinates, sizeof(double)*n);
+    ok = ok && writeSection(file, graph.offsets, sizeof(int)*(n+1));
+    ok = ok && writeSection(file, graph.targets, sizeof(int)*m);
+    if (header.sections & GRAPH_FILE_WEIGHTS){
+        ok = ok && writeSection(file, graph.weights, sizeof(EdgeWeight)*m);
+    }
+    if (header.sections & GRAPH_FILE_PARENTS){
+        ok = ok && writeSection(file, graph.parents, sizeof(int)*n);
+    }
+    if (header.sections & GRAPH_FILE_TOPOLOGICAL_ORDERING){
+        ok = ok && writeSection(file, graph.topological_ordering, sizeof(int)*n);
+    }
+    if (header.sections & GRAPH_FILE_START_DATES){
+        ok = ok && writeSection(file, earliestStart, sizeof(double)*n);
+        ok = ok && writeSection(file, latestStart, sizeof(double)*n);
+    }
+    if (fclose(file) != 0 || !ok){
+        printf("Error writing file %s\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Function to write a graph of adjacency lists in a binary file.
+ *
+ * @param filename The name of the file.
+ * @param graph The graph.
+ * @param sections The optional sections to write (GraphFileSection flags).
+ *
+ * @return 1 if the file is written, 0 otherwise.
+ */
+int writeGraphFile(const char *filename, Graph graph, uint32_t sections){
+    CSRGraph csr = createCSRGraphFromGraph(graph, (sections & GRAPH_FILE_WEIGHTS) != 0);
+    memcpy(csr.parents, graph.parents, sizeof(int)*graph.numberVertices);
+    memcpy(csr.topological_ordering, graph.topological_ordering, sizeof(int)*graph.numberVertices);
+    int dates = (sections & GRAPH_FILE_START_DATES) != 0;
+    int result = writeCSRGraphFile(filename, csr, graph.xCoordinates, graph.yCoordinates, graph.sigma,
+                                   dates ? graph.earliest_start : NULL, dates ? graph.latest_start : NULL, sections);
+    freeCSRGraph(&csr);
+    return result;
+}
+
+
+/**
+ * @brief Function to map a graph file in memory.
+ *
+ * @param filename The name of the file.
+ * @param mapped Pointer on the structure filled with the arrays of the file.
+ *
+ * @return 1 if the file is mapped, 0 if it can't be read or is not a valid graph file.
+ */
+int mapGraphFile(const char *filename, MappedGraph *mapped){
+    memset(mapped, 0, sizeof(MappedGraph));
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0){
+        printf("Error opening file %s\n", filename);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0 || (size_t) info.st_size < sizeof(GraphFileHeader)){
+        printf("Error: %s is not a graph file\n", filename);
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t) info.st_size;
+    /* private mapping: the traversals can write in the arrays without modifying the file */
+    char *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED){
+        printf("Error mapping file %s\n", filename);
+        return 0;
+    }
+    GraphFileHeader *header = (GraphFileHeader *) data;
+    size_t positions[NUMBER_OF_SECTIONS];
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0
+        || header->version != GRAPH_FILE_VERSION || header->byteOrder != GRAPH_FILE_BYTE_ORDER
+        || header->numberVertices > INT32_MAX || header->numberEdges > INT32_MAX
+        || graphFileLayout(header, positions) != size
+        || ((int *) (data + positions[SECTION_OFFSETS]))[header->numberVertices] != (int) header->numberEdges){
+        printf("Error: %s is not a valid graph file\n", filename);
+        munmap(data, size);
+        return 0;
+    }
+    if ((header->sections & GRAPH_FILE_WEIGHTS) && header->weightSize != sizeof(EdgeWeight)){
+        printf("Error: the weights of %s have %u bytes, not %zu\n", filename, header->weightSize, sizeof(EdgeWeight));
+        munmap(data, size);
+        return 0;
+    }
+    int n = (int) header->numberVertices;
+    mapped->mapping = data;
+    mapped->size = size;
+    mapped->sections = header->sections;
+    mapped->sigma = header->sigma;
+    mapped->xCoordinates = (double *) (data + positions[SECTION_X]);
+    mapped->yCoordinates = (double *) (data + positions[SECTION_Y]);
+    mapped->graph.numberVertices = n;
+    mapped->graph.numberEdges = (int) header->numberEdges;
+    mapped->graph.offsets = (int *) (data + positions[SECTION_OFFSETS]);
+    mapped->graph.targets = (int *) (data + positions[SECTION_TARGETS]);
+    mapped->graph.weights = positions[SECTION_WEIGHTS] ? (EdgeWeight *) (data + positions[SECTION_WEIGHTS]) : NULL;
+    mapped->earliest_start = positions[SECTION_EARLIEST] ? (double *) (data + positions[SECTION_EARLIEST]) : NULL;
+    mapped->latest_start = positions[SECTION_LATEST] ? (double *) (data + positions[SECTION_LATEST]) : NULL;
+    if (positions[SECTION_PARENTS]){
+        mapped->graph.parents = (int *) (data + positions[SECTION_PARENTS]);
+    }
+    else{
+        mapped->graph.parents = malloc(sizeof(int)*(n > 0 ? n : 1));
+        for (int i = 0; i<n; i++){
+            mapped->graph.parents[i] = -1;
+        }
+    }
+    if (positions[SECTION_ORDERING]){
+        mapped->graph.topological_ordering = (int *) (data + positions[SECTION_ORDERING]);
+    }
+    else{
+        mapped->graph.topological_ordering = malloc(sizeof(int)*(n > 0 ? n : 1));
+        for (int i = 0; i<n; i++){
+            mapped->graph.topological_ordering[i] = -1;
+        }
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Function to unmap a graph file mapped with mapGraphFile.
+ *
+ * @param mapped Pointer on the mapped graph.
+ */
+void unmapGraphFile(MappedGraph *mapped){
+    if (mapped->mapping == NULL){
+        return;
+    }
+    if (!(mapped->sections & GRAPH_FILE_PARENTS)){
+        free(mapped->graph.parents);
+    }
+    if (!(mapped->sections & GRAPH_FILE_TOPOLOGICAL_ORDERING)){
+        free(mapped->graph.topological_ordering);
+    }
+    munmap(mapped->mapping, mapped->size);
+    memset(mapped, 0, sizeof(MappedGraph));
+}
+
+
+/**
+ * @brief Function to build a graph of adjacency lists from a mapped graph file.
+ *
+ * @param mapped The mapped graph.
+ *
+ * @return A new graph, with the lists in the order of the file.
+ */
+Graph createGraphFromMappedGraph(MappedGraph mapped){
+    int n = mapped.graph.numberVertices;
+    Graph graph;
+    graph.numberVertices = n;
+    graph.capacity = n;
+    graph.connectivity = NULL;
+    graph.incoming = NULL;
+    graph.sigma = mapped.sigma;
+    graph.array = malloc(sizeof(List*)*n);
+    graph.xCoordinates = malloc(sizeof(double)*n);
+    graph.yCoordinates = malloc(sizeof(double)*n);
+    graph.parents = malloc(sizeof(int)*n);
+    graph.topological_ordering = malloc(sizeof(int)*n);
+    graph.earliest_start = malloc(sizeof(double)*n);
+    graph.latest_start = malloc(sizeof(double)*n);
+    memcpy(graph.xCoordinates, mapped.xCoordinates, sizeof(double)*n);
+    memcpy(graph.yCoordinates, mapped.yCoordinates, sizeof(double)*n);
+    memcpy(graph.parents, mapped.graph.parents, sizeof(int)*n);
+    memcpy(graph.topological_ordering, mapped.graph.topological_ordering, sizeof(int)*n);
+    for (int i = 0; i<n; i++){
+        graph.earliest_start[i] = mapped.earliest_start ? mapped.earliest_start[i] : -1.00;
+        graph.latest_start[i] = mapped.latest_start ? mapped.latest_start[i] : -1.00;
+        graph.array[i] = newList();
+        /* the cells are added at the head of the lists */
+        for (int k = mapped.graph.offsets[i+1]-1; k >= mapped.graph.offsets[i]; k--){
+            addEdgeInGraph(graph, i, mapped.graph.targets[k]);
+        }
+    }
+    return graph;
+}
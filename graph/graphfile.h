@@ -0,0 +1,132 @@
+/**
+ * @file graphfile.h
+ *
+ * @brief This file defines a binary file format for graphs, loaded with mmap.
+ *
+ * A file contains a header, the coordinates of the points, the CSR arrays
+ * (offsets and targets) and optional sections (weights, parents, topological
+ * ordering, start dates). Each section is aligned on 8 bytes, so that a mapped
+ * file is used in place without any copy or parsing.
+ */
+
+#ifndef GRAPHFILE_H
+#define GRAPHFILE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "graph.h"
+#include "csrgraph.h"
+
+
+/**
+ * @brief Optional sections of a graph file.
+ */
+typedef enum graphFileSection {
+    GRAPH_FILE_WEIGHTS = 1, /** weight of each edge, of type EdgeWeight */
+    GRAPH_FILE_PARENTS = 2, /** array parents */
+    GRAPH_FILE_TOPOLOGICAL_ORDERING = 4, /** array topological_ordering */
+    GRAPH_FILE_START_DATES = 8 /** arrays earliest_start and latest_start */
+} GraphFileSection;
+
+
+/**
+ * @brief Header at the beginning of a graph file.
+ */
+typedef struct GraphFileHeader {
+    char magic[8];   /** "CSRGRAPH" */
+    uint32_t version;   /** version of the format. */
+    uint32_t sections;   /** optional sections in the file (GraphFileSection flags). */
+    uint64_t numberVertices;   /** number of vertices. */
+    uint64_t numberEdges;   /** number of oriented edges. */
+    double sigma;   /** parameter sigma of the graph. */
+    uint32_t byteOrder;   /** 0x01020304 written in the byte order of the machine that wrote the file. */
+    uint32_t weightSize;   /** size in bytes of a weight (sizeof(EdgeWeight) of the writer), 0 if there are no weights. */
+} GraphFileHeader;
+
+
+/**
+ * @brief A graph file mapped in memory.
+ *
+ * The arrays point into the mapping, which is private: writing in them
+ * (a traversal writes parents for instance) never modifies the file.
+ * If a section is not in the file, its pointers are NULL, except parents
+ * and topological_ordering which are then allocated and set to -1, so that
+ * the traversals of csrgraph.h can be used on graph.
+ */
+typedef struct MappedGraph {
+    CSRGraph graph;   /** the graph, its arrays must not be freed with freeCSRGraph. */
+    double sigma;   /** parameter sigma of the graph. */
+    double *xCoordinates;   /** array of the x coordinates of the points. */
+    double *yCoordinates;   /** array of the y coordinates of the points. */
+    double *earliest_start;   /** array of the earliest start of each node, NULL if not in the file. */
+    double *latest_start;   /** array of the latest start of each node, NULL if not in the file. */
+    uint32_t sections;   /** optional sections of the file. */
+    void *mapping;   /** start of the mapping. */
+    size_t size;   /** size of the mapping. */
+} MappedGraph;
+
+
+/**
+ * @brief Function to write a graph in CSR format in a binary file.
+ *
+ * @param filename The name of the file.
+ * @param graph The graph. Its weights are written if graph.weights is not NULL.
+ * @param xCoordinates The x coordinates of the points.
+ * @param yCoordinates The y coordinates of the points.
+ * @param sigma Parameter sigma of the graph.
+ * @param earliestStart The earliest start dates, or NULL.
+ * @param latestStart The latest start dates, or NULL (written only if both dates are given).
+ * @param sections The optional sections to write among GRAPH_FILE_PARENTS and GRAPH_FILE_TOPOLOGICAL_ORDERING
+ * (the other sections are given by the NULL pointers).
+ *
+ * @return 1 if the file is written, 0 otherwise.
+ */
+int writeCSRGraphFile(const char *filename, CSRGraph graph, const double *xCoordinates, const double *yCoordinates,
+                      double sigma, const double *earliestStart, const double *latestStart, uint32_t sections);
+
+/**
+ * @brief Function to write a graph of adjacency lists in a binary file.
+ *
+ * @param filename The name of the file.
+ * @param graph The graph.
+ * @param sections The optional sections to write (GraphFileSection flags).
+ *
+ * @return 1 if the file is written, 0 otherwise.
+ *
+ * The successors of each vertex are written in the order of its list, and the weights are the
+ * euclidean distances, so createGraphFromMappedGraph gives back the same graph.
+ */
+int writeGraphFile(const char *filename, Graph graph, uint32_t sections);
+
+/**
+ * @brief Function to map a graph file in memory.
+ *
+ * @param filename The name of the file.
+ * @param mapped Pointer on the structure filled with the arrays of the file.
+ *
+ * @return 1 if the file is mapped, 0 if it can't be read or is not a valid graph file.
+ * A file whose weights are not of the type EdgeWeight of this build is rejected.
+ *
+ * Only the header is read: the pages of the arrays are loaded when they are used.
+ */
+int mapGraphFile(const char *filename, MappedGraph *mapped);
+
+/**
+ * @brief Function to unmap a graph file mapped with mapGraphFile.
+ *
+ * @param mapped Pointer on the mapped graph.
+ */
+void unmapGraphFile(MappedGraph *mapped);
+
+/**
+ * @brief Function to build a graph of adjacency lists from a mapped graph file.
+ *
+ * @param mapped The mapped graph.
+ *
+ * @return A new graph, to free with freeGraph, with the lists in the order of the file.
+ * The arrays that are not in the file are set to -1.
+ */
+Graph createGraphFromMappedGraph(MappedGraph mapped);
+
+#endif // GRAPHFILE_H
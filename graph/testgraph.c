@@ -1,7 +1,937 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "graph.h"
+#include "csrgraph.h"
+#include "graphfile.h"
+#include <math.h>
 #include "time.h"
+#include <unistd.h>
+
+/**
+ * @brief Returns the time elapsed since start in seconds
+ */
+double elapsedSeconds(struct timespec start){
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec)/1e9;
+}
+
+/**
+ * @brief Returns 1 if both arrays of parents are equal, 0 otherwise
+ */
+int sameParents(int *parents1, int *parents2, int n){
+    for (int i = 0; i<n; i++){
+        if (parents1[i] != parents2[i])
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Adds degree random undirected edges from each vertex of a graph without edges
+ */
+void addRandomEdges(Graph graph, int degree){
+    for (int i = 0; i<graph.numberVertices; i++){
+        for (int k = 0; k<degree; k++){
+            int j = rand() % graph.numberVertices;
+            if (j != i){
+                addEdgeInGraph(graph, i, j);
+                addEdgeInGraph(graph, j, i);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compares the traversals of a graph of adjacency lists and of the same graph in CSR format
+ */
+void testCSRGraph(){
+    printf("---- Test CSR graph ----\n");
+    Graph graph = createGraph(0, 2000, 0.05);
+    CSRGraph csr = createCSRGraphFromGraph(graph, 0);
+    graphDFS(graph, 0);
+    csrGraphDFS(csr, 0);
+    printf("DFS : %s parents\n", sameParents(graph.parents, csr.parents, graph.numberVertices) ? "same" : "DIFFERENT");
+    for (int i = 0; i<graph.numberVertices; i++){
+        graph.parents[i] = -1;
+        csr.parents[i] = -1;
+    }
+    graphBFS(graph, 0);
+    csrGraphBFS(csr, 0);
+    printf("BFS : %s parents\n", sameParents(graph.parents, csr.parents, graph.numberVertices) ? "same" : "DIFFERENT");
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+
+    int n = 1000000;
+    graph = createGraphWithoutEdges(n, 0, rngDefault());
+    addRandomEdges(graph, 4);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    csr = createCSRGraphFromGraph(graph, 0);
+    printf("%d vertices, %d edges, conversion in CSR format : %.3lf s\n", n, csr.numberEdges, elapsedSeconds(start));
+    for (int type = 0; type < 2; type++){
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (type == 0)
+            graphDFS(graph, 0);
+        else
+            graphBFS(graph, 0);
+        double tList = elapsedSeconds(start);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (type == 0)
+            csrGraphDFS(csr, 0);
+        else
+            csrGraphBFS(csr, 0);
+        double tCSR = elapsedSeconds(start);
+        printf("%s : lists %.3lf s (%.1lf Medges/s), CSR %.3lf s (%.1lf Medges/s), %s parents\n",
+               type == 0 ? "DFS" : "BFS", tList, csr.numberEdges/tList/1e6, tCSR, csr.numberEdges/tCSR/1e6,
+               sameParents(graph.parents, csr.parents, n) ? "same" : "DIFFERENT");
+        for (int i = 0; i<n; i++){
+            graph.parents[i] = -1;
+            csr.parents[i] = -1;
+        }
+    }
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test CSR graph ----\n");
+}
+
+/**
+ * @brief Returns 1 if the adjacency lists of a graph are exactly the ones built by
+ * the all-pairs procedure (edges added for j increasing, so lists in decreasing order)
+ */
+int sameEdgesAsAllPairs(Graph graph, int directed){
+    for (int i = 0; i<graph.numberVertices; i++){
+        Cell* tmp = graph.array[i];
+        for (int j = graph.numberVertices-1; j>=0; j--){
+            double d = distance(graph.xCoordinates[i], graph.yCoordinates[i], graph.xCoordinates[j], graph.yCoordinates[j]);
+            if (d < graph.sigma && i!=j && (directed == 0 || graph.yCoordinates[i] < graph.yCoordinates[j])){
+                if (tmp == NULL || tmp->value != j)
+                    return 0;
+                tmp = tmp->nextCell;
+            }
+        }
+        if (tmp != NULL)
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Checks the edges of createGraph against the all-pairs procedure and measures its time
+ */
+void testGridGeneration(){
+    printf("---- Test grid generation ----\n");
+    double sigmas[3] = {0.01, 0.05, 0.3};
+    for (int directed = 0; directed < 2; directed++){
+        for (int k = 0; k < 3; k++){
+            Graph graph = createGraph(directed, 3000, sigmas[k]);
+            printf("%s, sigma=%.2lf : %s edges as the all-pairs procedure\n", directed ? "directed" : "undirected",
+                   sigmas[k], sameEdgesAsAllPairs(graph, directed) ? "same" : "DIFFERENT");
+            freeGraph(graph);
+        }
+    }
+    /* time of the all-pairs test alone, for an average degree of 8 */
+    int n = 10000;
+    double sigma = sqrt(8/(M_PI*n));
+    Graph graph = createGraphWithoutEdges(n, sigma, rngDefault());
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long nbEdges = 0;
+    for (int i = 0; i<n; i++){
+        for (int j = 0; j<n; j++){
+            if (distance(graph.xCoordinates[i], graph.yCoordinates[i], graph.xCoordinates[j], graph.yCoordinates[j]) < sigma && i!=j)
+                nbEdges++;
+        }
+    }
+    printf("%d vertices, all-pairs test : %.3lf s (%ld edges)\n", n, elapsedSeconds(start), nbEdges);
+    freeGraph(graph);
+    for (n = 10000; n <= 1000000; n *= 10){
+        sigma = sqrt(8/(M_PI*n));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        graph = createGraph(0, n, sigma);
+        double t = elapsedSeconds(start);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        CSRGraph csr = createCSRGraph(0, n, sigma, graph.xCoordinates, graph.yCoordinates, 0);
+        printf("%d vertices, grid : createGraph %.3lf s, createCSRGraph %.3lf s (%d edges)\n",
+               n, t, elapsedSeconds(start), csr.numberEdges);
+        freeCSRGraph(&csr);
+        freeGraph(graph);
+    }
+    printf("---- Fin test grid generation ----\n");
+}
+
+/**
+ * @brief Returns 1 if both graphs have the same lists in the same order, 0 otherwise
+ */
+int sameLists(Graph graph1, Graph graph2){
+    if (graph1.numberVertices != graph2.numberVertices)
+        return 0;
+    for (int i = 0; i<graph1.numberVertices; i++){
+        Cell* tmp1 = graph1.array[i];
+        Cell* tmp2 = graph2.array[i];
+        while (tmp1 != NULL && tmp2 != NULL){
+            if (tmp1->value != tmp2->value)
+                return 0;
+            tmp1 = tmp1->nextCell;
+            tmp2 = tmp2->nextCell;
+        }
+        if (tmp1 != tmp2)
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns 1 if both graphs in CSR format are equal, 0 otherwise
+ */
+int sameCSRGraphs(CSRGraph graph1, CSRGraph graph2){
+    if (graph1.numberVertices != graph2.numberVertices || graph1.numberEdges != graph2.numberEdges)
+        return 0;
+    for (int i = 0; i<=graph1.numberVertices; i++){
+        if (graph1.offsets[i] != graph2.offsets[i])
+            return 0;
+    }
+    for (int k = 0; k<graph1.numberEdges; k++){
+        if (graph1.targets[k] != graph2.targets[k])
+            return 0;
+        if (graph1.weights != NULL && graph1.weights[k] != graph2.weights[k])
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Returns the size of a file in bytes
+ */
+long fileSize(char *filename){
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+        return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+/**
+ * @brief Returns the number of segments of the first path of a color in a svg file of an undirected graph, -1 if there is none
+ */
+int countPathSegments(char *filename, char *color){
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+        return -1;
+    long size = fileSize(filename);
+    char *content = malloc(size+1);
+    size_t read = fread(content, 1, size, file);
+    content[read] = '\0';
+    fclose(file);
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "stroke=\"%s\" d=\"", color);
+    char *path = strstr(content, pattern);
+    int count = -1;
+    if (path != NULL){
+        count = 0;
+        for (char *p = path + strlen(pattern); *p != '\0' && *p != '"'; p++){
+            if (*p == 'M')
+                count++;
+        }
+    }
+    free(content);
+    return count;
+}
+
+/**
+ * @brief Computes the depth of each vertex in a covering tree (-1 for the vertices out of the tree)
+ */
+void depthsFromParents(int *parents, int n, int *depths){
+    int *path = malloc(sizeof(int)*n);
+    for (int i = 0; i<n; i++)
+        depths[i] = parents[i] < 0 ? -1 : -2;
+    for (int i = 0; i<n; i++){
+        int length = 0, v = i;
+        while (depths[v] == -2 && parents[v] != v){
+            path[length++] = v;
+            v = parents[v];
+        }
+        if (depths[v] == -2)
+            depths[v] = 0;
+        while (length > 0){
+            int u = path[--length];
+            depths[u] = depths[parents[u]] + 1;
+        }
+    }
+    free(path);
+}
+
+/**
+ * @brief Returns 1 if parents is a breadth first search tree with the same levels as reference, 0 otherwise
+ */
+int isSameLevelsTree(CSRGraph graph, int *parents, int *reference){
+    int n = graph.numberVertices;
+    int *depths = malloc(sizeof(int)*n);
+    int *referenceDepths = malloc(sizeof(int)*n);
+    depthsFromParents(parents, n, depths);
+    depthsFromParents(reference, n, referenceDepths);
+    int valid = 1;
+    for (int v = 0; v<n && valid; v++){
+        if (depths[v] != referenceDepths[v])
+            valid = 0;
+        else if (depths[v] > 0){
+            int isEdge = 0;
+            for (int e = graph.offsets[parents[v]]; e < graph.offsets[parents[v]+1]; e++){
+                if (graph.targets[e] == v)
+                    isEdge = 1;
+            }
+            valid = isEdge;
+        }
+    }
+    free(depths);
+    free(referenceDepths);
+    return valid;
+}
+
+/**
+ * @brief Compares the direction-optimizing breadth first search with csrGraphBFS and measures the traversed edges per second
+ */
+void testDirectionOptimizingBFS(){
+    printf("---- Test direction-optimizing BFS ----\n");
+    int n = 1000000;
+    double sigma = sqrt(16/(M_PI*n));
+    int nbThreads[3] = {1, 2, 4};
+    RandomGenerator generator;
+    rngSeed(&generator, 18);
+    double *xs = malloc(sizeof(double)*n);
+    double *ys = malloc(sizeof(double)*n);
+    for (int i = 0; i<n; i++){
+        xs[i] = rngDouble(&generator);
+        ys[i] = rngDouble(&generator);
+    }
+    int *reference = malloc(sizeof(int)*n);
+    int *firstTree = malloc(sizeof(int)*n);
+    /* geometric graphs (undirected and directed) have many small levels, a random graph has a few large ones */
+    for (int kind = 0; kind < 3; kind++){
+        int directed = kind == 1;
+        CSRGraph graph;
+        if (kind < 2){
+            graph = createCSRGraph(directed, n, sigma, xs, ys, 0);
+        }
+        else{
+            int m = 8*n;
+            int *origins = malloc(sizeof(int)*2*m);
+            int *destinations = malloc(sizeof(int)*2*m);
+            for (int e = 0; e<m; e++){
+                origins[2*e] = destinations[2*e+1] = rngBounded(&generator, n);
+                destinations[2*e] = origins[2*e+1] = rngBounded(&generator, n);
+            }
+            graph = createCSRGraphFromEdges(n, 2*m, origins, destinations, NULL);
+            free(origins);
+            free(destinations);
+        }
+        /* graph of the predecessors */
+        int *origins = malloc(sizeof(int)*(graph.numberEdges > 0 ? graph.numberEdges : 1));
+        for (int v = 0; v<n; v++){
+            for (int e = graph.offsets[v]; e < graph.offsets[v+1]; e++)
+                origins[e] = v;
+        }
+        CSRGraph incoming = createCSRGraphFromEdges(n, graph.numberEdges, graph.targets, origins, NULL);
+        free(origins);
+        /* the origin is the lowest point, so that the directed search reaches many vertices */
+        int origin = 0;
+        for (int v = 0; v<n; v++){
+            if (ys[v] < ys[origin])
+                origin = v;
+        }
+        for (int i = 0; i<n; i++)
+            graph.parents[i] = -1;
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        csrGraphBFS(graph, origin);
+        double t = elapsedSeconds(start);
+        memcpy(reference, graph.parents, sizeof(int)*n);
+        long edges = 0;
+        for (int v = 0; v<n; v++){
+            if (reference[v] >= 0)
+                edges += graph.offsets[v+1] - graph.offsets[v];
+        }
+        const char *names[3] = {"undirected geometric", "directed geometric", "random"};
+        printf("%s, %d vertices, %ld edges reached : csrGraphBFS %.3lf s (%.1lf MTEPS)\n", names[kind],
+               n, edges, t, edges/t/1e6);
+        for (int k = 0; k < 3; k++){
+            for (int i = 0; i<n; i++)
+                graph.parents[i] = -1;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            csrGraphDirectionOptimizingBFS(graph, directed ? &incoming : NULL, origin, nbThreads[k]);
+            t = elapsedSeconds(start);
+            if (k == 0)
+                memcpy(firstTree, graph.parents, sizeof(int)*n);
+            printf("%d threads : %.3lf s (%.1lf MTEPS), %s levels, %s tree as with 1 thread\n", nbThreads[k], t, edges/t/1e6,
+                   isSameLevelsTree(graph, graph.parents, reference) ? "same" : "DIFFERENT",
+                   sameParents(firstTree, graph.parents, n) ? "same" : "DIFFERENT");
+        }
+        freeCSRGraph(&incoming);
+        freeCSRGraph(&graph);
+    }
+    free(reference);
+    free(firstTree);
+    free(xs);
+    free(ys);
+    printf("---- Fin test direction-optimizing BFS ----\n");
+}
+
+/**
+ * @brief Checks the connected components against numberOfComponents and a serial labelling,
+ * checks the covering forest and measures the time on a large graph
+ */
+void testConnectedComponents(){
+    printf("---- Test connected components ----\n");
+    int nbThreads[3] = {1, 2, 4};
+    RandomGenerator generator;
+    rngSeed(&generator, 19);
+    /* small sigma: many components */
+    for (int directed = 0; directed < 2; directed++){
+        int n = 20000;
+        Graph lists = createGraphWithGenerator(directed, n, 0.006, &generator);
+        CSRGraph graph = createCSRGraphFromGraph(lists, 0);
+        /* serial reference: a BFS on the undirected graph from the smallest vertex of each component,
+           and numberOfComponents for an undirected graph */
+        int *origins = malloc(sizeof(int)*2*(graph.numberEdges > 0 ? graph.numberEdges : 1));
+        int *destinations = malloc(sizeof(int)*2*(graph.numberEdges > 0 ? graph.numberEdges : 1));
+        for (int v = 0; v<n; v++){
+            for (int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                origins[2*e] = destinations[2*e+1] = v;
+                destinations[2*e] = origins[2*e+1] = graph.targets[e];
+            }
+        }
+        CSRGraph symmetric = createCSRGraphFromEdges(n, 2*graph.numberEdges, origins, destinations, NULL);
+        free(origins);
+        free(destinations);
+        int *reference = malloc(sizeof(int)*n);
+        int count = 0;
+        for (int v = 0; v<n; v++){
+            if (symmetric.parents[v] == -1){
+                count++;
+                csrGraphBFS(symmetric, v);
+            }
+        }
+        for (int v = 0; v<n; v++){
+            int root = v;
+            while (symmetric.parents[root] != root)
+                root = symmetric.parents[root];
+            reference[v] = root;
+        }
+        int *components = malloc(sizeof(int)*n);
+        for (int k = 0; k < 3; k++){
+            int found = csrConnectedComponents(graph, components, nbThreads[k], 1);
+            int sameComponents = sameParents(components, reference, n);
+            /* a forest: one root by component, n-count edges of the graph, all in the component of their root */
+            int validForest = 1;
+            int forestEdges = 0;
+            for (int v = 0; v<n && validForest; v++){
+                int p = graph.parents[v];
+                if (p == v){
+                    validForest = components[v] == v;
+                    continue;
+                }
+                forestEdges++;
+                int edge = 0;
+                for (int e = symmetric.offsets[v]; e < symmetric.offsets[v+1]; e++)
+                    edge |= symmetric.targets[e] == p;
+                validForest = edge && components[p] == components[v];
+            }
+            printf("%s, %d threads : %d components (%s count as the serial search), %s components, %s forest\n",
+                   directed ? "directed" : "undirected", nbThreads[k], found,
+                   (directed || found == numberOfComponents(lists)) && found == count ? "same" : "DIFFERENT",
+                   sameComponents ? "same" : "DIFFERENT",
+                   validForest && forestEdges == n - found ? "valid" : "DIFFERENT");
+        }
+        free(components);
+        free(reference);
+        freeCSRGraph(&symmetric);
+        freeCSRGraph(&graph);
+        freeGraph(lists);
+    }
+    /* large graph with a mean degree of about 4 */
+    int n = 1000000;
+    double sigma = sqrt(4/(M_PI*n));
+    double *xs = malloc(sizeof(double)*n);
+    double *ys = malloc(sizeof(double)*n);
+    for (int i = 0; i<n; i++){
+        xs[i] = rngDouble(&generator);
+        ys[i] = rngDouble(&generator);
+    }
+    CSRGraph graph = createCSRGraph(0, n, sigma, xs, ys, 0);
+    int *components = malloc(sizeof(int)*n);
+    int *firstComponents = malloc(sizeof(int)*n);
+    struct timespec start;
+    for (int i = 0; i<n; i++)
+        graph.parents[i] = -1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int count = 0;
+    for (int v = 0; v<n; v++){
+        if (graph.parents[v] == -1){
+            count++;
+            csrGraphBFS(graph, v);
+        }
+    }
+    double reference = elapsedSeconds(start);
+    printf("%d vertices, %d edges, %d components : BFS from each component %.3lf s\n", n, graph.numberEdges, count, reference);
+    for (int k = 0; k < 3; k++){
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int found = csrConnectedComponents(graph, components, nbThreads[k], 0);
+        double t = elapsedSeconds(start);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        csrConnectedComponents(graph, components, nbThreads[k], 1);
+        double tForest = elapsedSeconds(start);
+        if (k == 0)
+            memcpy(firstComponents, components, sizeof(int)*n);
+        printf("%d threads : %.3lf s, with the forest %.3lf s, %s number, %s components as with 1 thread\n",
+               nbThreads[k], t, tForest, found == count ? "same" : "DIFFERENT",
+               sameParents(firstComponents, components, n) ? "same" : "DIFFERENT");
+    }
+    free(components);
+    free(firstComponents);
+    freeCSRGraph(&graph);
+    free(xs);
+    free(ys);
+    printf("---- Fin test connected components ----\n");
+}
+
+/**
+ * @brief Returns 1 if the tracked components of a graph are its connected components, 0 otherwise
+ */
+int sameTrackedComponents(Graph graph){
+    CSRGraph csr = createCSRGraphFromGraph(graph, 0);
+    int *components = malloc(sizeof(int)*(graph.numberVertices > 0 ? graph.numberVertices : 1));
+    int count = csrConnectedComponents(csr, components, 1, 0);
+    /* the partition of components is finer than the tracked one, and they have as many parts */
+    int same = count == numberOfTrackedComponents(graph);
+    for (int v = 0; v<graph.numberVertices && same; v++)
+        same = componentOfVertex(graph, v) == componentOfVertex(graph, components[v]);
+    free(components);
+    freeCSRGraph(&csr);
+    return same;
+}
+
+/**
+ * @brief Checks the components maintained while vertices and edges are added and measures the time of an update
+ */
+void testIncrementalConnectivity(){
+    printf("---- Test incremental connectivity ----\n");
+    RandomGenerator generator;
+    for (int directed = 0; directed < 2; directed++){
+        int n = 3000;
+        double sigma = 0.02;
+        rngSeed(&generator, 20);
+        Graph reference = createGraphWithGenerator(directed, n, sigma, &generator);
+        Graph grown = createGraphWithoutEdges(0, sigma, &generator);
+        trackConnectivity(&grown);
+        int same = 1;
+        for (int i = 0; i<n; i++){
+            addVertexInGraph(&grown, directed, reference.xCoordinates[i], reference.yCoordinates[i]);
+            if ((i+1) % 500 == 0)
+                same = same && sameTrackedComponents(grown);
+        }
+        int count = numberOfTrackedComponents(grown);
+        printf("%s, %d vertices added one by one : %s lists as createGraph, %d components, %s components",
+               directed ? "directed" : "undirected", n, sameLists(grown, reference) ? "same" : "DIFFERENT",
+               count, same ? "same" : "DIFFERENT");
+        if (!directed)
+            printf(", %s number as numberOfComponents", count == numberOfComponents(grown) ? "same" : "DIFFERENT");
+        printf("\n");
+        freeGraph(grown);
+        freeGraph(reference);
+    }
+    /* components of an existing graph, then random edges */
+    int n = 100000;
+    rngSeed(&generator, 20);
+    Graph graph = createGraphWithGenerator(0, n, sqrt(2/(M_PI*n)), &generator);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int count = numberOfComponents(graph);
+    double full = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    trackConnectivity(&graph);
+    double track = elapsedSeconds(start);
+    printf("%d vertices, %d components : numberOfComponents %.3lf s, trackConnectivity %.3lf s, %s number\n",
+           n, count, full, track, count == numberOfTrackedComponents(graph) ? "same" : "DIFFERENT");
+    int m = 100000;
+    long checksum = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int e = 0; e<m; e++){
+        int origin = rngBounded(&generator, n);
+        int destination = rngBounded(&generator, n);
+        addEdgeInGraph(graph, origin, destination);
+        addEdgeInGraph(graph, destination, origin);
+        checksum += numberOfTrackedComponents(graph) + componentOfVertex(graph, origin);
+    }
+    double t = elapsedSeconds(start);
+    printf("%d random edges added and queried : %.3lf us per edge, %s components (%d left, checksum %ld)\n",
+           m, t/m*1e6, sameTrackedComponents(graph) ? "same" : "DIFFERENT", numberOfTrackedComponents(graph), checksum);
+    freeGraph(graph);
+    printf("---- Fin test incremental connectivity ----\n");
+}
+
+/**
+ * @brief Compares two vertices for qsort
+ */
+int compareInts(const void *a, const void *b){
+    return *(const int *) a - *(const int *) b;
+}
+
+/**
+ * @brief Returns 1 if the index of a graph has the origins of its edges as predecessors, 0 otherwise.
+ * If ordered!=0, the predecessors must also be in increasing order.
+ */
+int samePredecessors(Graph graph, int ordered){
+    int n = graph.numberVertices;
+    int m = 0;
+    for (int i = 0; i<n; i++){
+        for (Cell* tmp = graph.array[i]; tmp != NULL; tmp = tmp->nextCell)
+            m++;
+    }
+    int *origins = malloc(sizeof(int)*(m > 0 ? m : 1));
+    int *destinations = malloc(sizeof(int)*(m > 0 ? m : 1));
+    m = 0;
+    for (int i = 0; i<n; i++){
+        for (Cell* tmp = graph.array[i]; tmp != NULL; tmp = tmp->nextCell){
+            origins[m] = i;
+            destinations[m++] = tmp->value;
+        }
+    }
+    /* the predecessors of each vertex in increasing order */
+    CSRGraph expected = createCSRGraphFromEdges(n, m, destinations, origins, NULL);
+    int *predecessors = malloc(sizeof(int)*(n > 0 ? n : 1));
+    int same = 1;
+    for (int v = 0; v<n && same; v++){
+        int degree = graph.incoming->inDegrees[v];
+        same = degree == expected.offsets[v+1] - expected.offsets[v];
+        if (same){
+            memcpy(predecessors, graph.incoming->predecessors[v], sizeof(int)*degree);
+            if (!ordered)
+                qsort(predecessors, degree, sizeof(int), compareInts);
+            same = memcmp(predecessors, expected.targets + expected.offsets[v], sizeof(int)*degree) == 0;
+        }
+    }
+    free(predecessors);
+    freeCSRGraph(&expected);
+    free(origins);
+    free(destinations);
+    return same;
+}
+
+/**
+ * @brief Checks the index of the incoming edges while a graph grows and measures the predecessor queries
+ */
+void testIncomingEdges(){
+    printf("---- Test incoming edges ----\n");
+    RandomGenerator generator;
+    rngSeed(&generator, 23);
+    int n = 3000;
+    double sigma = 0.03;
+    /* index of a graph, then of the same graph grown point by point */
+    Graph reference = createGraphWithGenerator(1, n, sigma, &generator);
+    trackIncomingEdges(&reference);
+    Graph grown = createGraphWithoutEdges(0, sigma, &generator);
+    trackIncomingEdges(&grown);
+    for (int i = 0; i<n; i++)
+        addVertexInGraph(&grown, 1, reference.xCoordinates[i], reference.yCoordinates[i]);
+    int same = 1;
+    for (int v = 0; v<n && same; v++){
+        same = grown.incoming->inDegrees[v] == reference.incoming->inDegrees[v]
+            && memcmp(grown.incoming->predecessors[v], reference.incoming->predecessors[v], sizeof(int)*grown.incoming->inDegrees[v]) == 0;
+    }
+    printf("directed, %d vertices : %s predecessors as the edges, %s predecessors when the points are added one by one\n", n,
+           samePredecessors(reference, 1) ? "same" : "DIFFERENT", same ? "same" : "DIFFERENT");
+    freeGraph(grown);
+    freeGraph(reference);
+    /* large graph: one predecessor query by scanning the lists against the index */
+    n = 1000000;
+    Graph graph = createGraphWithGenerator(1, n, sqrt(8/(M_PI*n)), &generator);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    trackIncomingEdges(&graph);
+    double tBuild = elapsedSeconds(start);
+    int vertex = n/2;
+    char key[10];
+    sprintf(key, "%d", vertex);
+    int found = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i<n; i++){
+        if (findKeyInList(graph.array[i], key) != NULL)
+            found++;
+    }
+    double tScan = elapsedSeconds(start);
+    int sources = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i<n; i++){
+        if (graph.incoming->inDegrees[i] == 0)
+            sources++;
+    }
+    double tSources = elapsedSeconds(start);
+    for (int e = 0; e<100000; e++){
+        int origin = rngBounded(&generator, n);
+        int destination = rngBounded(&generator, n);
+        if (graph.yCoordinates[origin] < graph.yCoordinates[destination])
+            addEdgeInGraph(graph, origin, destination);
+    }
+    printf("%d vertices : index built in %.3lf s, predecessors of a vertex by scanning the lists %.3lf s, "
+           "%s in-degree, %d sources found in %.4lf s, %s predecessors after adding edges\n",
+           n, tBuild, tScan, found == graph.incoming->inDegrees[vertex] ? "same" : "DIFFERENT", sources, tSources,
+           samePredecessors(graph, 0) ? "same" : "DIFFERENT");
+    freeGraph(graph);
+    printf("---- Fin test incoming edges ----\n");
+}
+
+/**
+ * @brief Checks the number of edges drawn in svg files and measures the time and size for a large graph
+ */
+void testDrawGraph(){
+    printf("---- Test svg files ----\n");
+    RandomGenerator generator;
+    rngSeed(&generator, 17);
+    for (int directed = 0; directed < 2; directed++){
+        Graph graph = createGraphWithGenerator(directed, 500, 0.08, &generator);
+        int numEdges = 0;
+        for (int i = 0; i<graph.numberVertices; i++){
+            for (Cell* tmp = graph.array[i]; tmp != NULL; tmp = tmp->nextCell)
+                numEdges++;
+        }
+        if (directed == 0)
+            numEdges /= 2;
+        graphBFS(graph, 0);
+        int treeEdges = 0;
+        for (int i = 0; i<graph.numberVertices; i++){
+            if (graph.parents[i] >= 0 && graph.parents[i] != i)
+                treeEdges++;
+        }
+        int drawnGraph = drawGraphWithDetail(graph, "test-graph.svg", 0, directed, 0);
+        int drawnTree = drawGraphWithDetail(graph, "test-graph.svg", 1, directed, 0);
+        int drawnBoth = drawGraphWithDetail(graph, "test-graph.svg", 2, directed, 0);
+        printf("%s : %d/%d edges, %d/%d tree edges, %d/%d edges with the tree\n", directed ? "directed" : "undirected",
+               drawnGraph, numEdges, drawnTree, treeEdges, drawnBoth, numEdges);
+        freeGraph(graph);
+    }
+    remove("test-graph.svg");
+    int n = 100000;
+    double sigma = sqrt(8/(M_PI*n));
+    Graph graph = createGraphWithGenerator(0, n, sigma, &generator);
+    graphBFS(graph, 0);
+    int treeEdges = 0;
+    for (int i = 0; i<n; i++){
+        if (graph.parents[i] >= 0 && graph.parents[i] != i)
+            treeEdges++;
+    }
+    for (int decimate = 0; decimate <= 4; decimate += 2){
+        int drawnTree = drawGraphWithDetail(graph, "test-graph.svg", 1, 0, decimate);
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int drawn = drawGraphWithDetail(graph, "test-graph.svg", 2, 0, decimate);
+        double t = elapsedSeconds(start);
+        int drawnTreeWithGraph = countPathSegments("test-graph.svg", "red");
+        printf("%d vertices, cells of %d pixels : %.3lf s, %d edges drawn, %.1lf MB, %d/%d tree edges, %s tree with the graph\n",
+               n, decimate, t, drawn, fileSize("test-graph.svg")/1e6, drawnTree, treeEdges,
+               drawnTreeWithGraph == drawnTree ? "same" : "DIFFERENT");
+    }
+    remove("test-graph.svg");
+    freeGraph(graph);
+    printf("---- Fin test svg files ----\n");
+}
+
+/**
+ * @brief Writes graphs in binary files, maps them and compares the loading time with the generation time
+ */
+void testGraphFile(){
+    printf("---- Test graph files ----\n");
+    RandomGenerator generator;
+    rngSeed(&generator, 16);
+    Graph graph = createGraphWithGenerator(1, 2000, 0.05, &generator);
+    for (int i = 0; i<graph.numberVertices; i++){
+        graph.parents[i] = i/2;
+        graph.earliest_start[i] = i;
+        graph.latest_start[i] = 2*i;
+    }
+    MappedGraph mapped;
+    int ok = writeGraphFile("graph.bin", graph, GRAPH_FILE_WEIGHTS | GRAPH_FILE_PARENTS | GRAPH_FILE_START_DATES)
+             && mapGraphFile("graph.bin", &mapped);
+    if (ok){
+        Graph loaded = createGraphFromMappedGraph(mapped);
+        int sameArrays = loaded.sigma == graph.sigma && mapped.graph.weights != NULL;
+        for (int i = 0; i<graph.numberVertices; i++){
+            if (loaded.xCoordinates[i] != graph.xCoordinates[i] || loaded.yCoordinates[i] != graph.yCoordinates[i]
+                || loaded.parents[i] != graph.parents[i] || loaded.topological_ordering[i] != -1
+                || loaded.earliest_start[i] != graph.earliest_start[i] || loaded.latest_start[i] != graph.latest_start[i])
+                sameArrays = 0;
+        }
+        printf("adjacency lists : %s lists, %s arrays after writing and mapping\n",
+               sameLists(graph, loaded) ? "same" : "DIFFERENT", sameArrays ? "same" : "DIFFERENT");
+        freeGraph(loaded);
+        unmapGraphFile(&mapped);
+    }
+    freeGraph(graph);
+    /* a truncated file is rejected */
+    if (truncate("graph.bin", 100) == 0){
+        printf("truncated file : %s\n", mapGraphFile("graph.bin", &mapped) ? "ACCEPTED" : "rejected");
+    }
+
+    int n = 1000000;
+    double sigma = sqrt(8/(M_PI*n));
+    double *xs = malloc(sizeof(double)*n);
+    double *ys = malloc(sizeof(double)*n);
+    for (int i = 0; i<n; i++){
+        xs[i] = rngBounded(&generator, 1000001)/1000000.0;
+        ys[i] = rngBounded(&generator, 1000001)/1000000.0;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CSRGraph csr = createCSRGraph(0, n, sigma, xs, ys, 0);
+    double generation = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ok = writeCSRGraphFile("graph.bin", csr, xs, ys, sigma, NULL, NULL, 0);
+    double writing = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ok = ok && mapGraphFile("graph.bin", &mapped);
+    double mapping = elapsedSeconds(start);
+    if (ok){
+        csrGraphBFS(csr, 0);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        csrGraphBFS(mapped.graph, 0);
+        double traversal = elapsedSeconds(start);
+        printf("%d vertices, %d edges : generation %.3lf s, writing %.3lf s, mapping %.6lf s, "
+               "first BFS on the mapped graph %.3lf s, %s graph, %s parents\n", n, csr.numberEdges,
+               generation, writing, mapping, traversal, sameCSRGraphs(csr, mapped.graph) ? "same" : "DIFFERENT",
+               sameParents(csr.parents, mapped.graph.parents, n) ? "same" : "DIFFERENT");
+        unmapGraphFile(&mapped);
+    }
+    remove("graph.bin");
+    freeCSRGraph(&csr);
+    free(xs);
+    free(ys);
+    printf("---- Fin test graph files ----\n");
+}
+
+/**
+ * @brief Compares the parallel generation with the serial one and measures the speedup
+ */
+void testParallelGeneration(){
+    printf("---- Test parallel generation ----\n");
+    int nbThreads[4] = {1, 2, 4, 8};
+    uint64_t seed = (uint64_t) time(NULL);
+    RandomGenerator generator;
+    for (int directed = 0; directed < 2; directed++){
+        rngSeed(&generator, seed);
+        Graph graph = createGraphWithGenerator(directed, 5000, 0.03, &generator);
+        CSRGraph csr = createCSRGraph(directed, 5000, 0.03, graph.xCoordinates, graph.yCoordinates, 1);
+        for (int k = 0; k < 4; k++){
+            rngSeed(&generator, seed);
+            Graph parallel = createGraphParallel(directed, 5000, 0.03, nbThreads[k], &generator);
+            CSRGraph parallelCsr = createCSRGraphParallel(directed, 5000, 0.03, graph.xCoordinates, graph.yCoordinates, 1, nbThreads[k]);
+            printf("%s, %d threads : %s lists, %s CSR graph as the serial generation\n", directed ? "directed" : "undirected",
+                   nbThreads[k], sameLists(graph, parallel) ? "same" : "DIFFERENT",
+                   sameCSRGraphs(csr, parallelCsr) ? "same" : "DIFFERENT");
+            freeCSRGraph(&parallelCsr);
+            freeGraph(parallel);
+        }
+        freeCSRGraph(&csr);
+        freeGraph(graph);
+    }
+    int n = 1000000;
+    double sigma = sqrt(8/(M_PI*n));
+    struct timespec start;
+    rngSeed(&generator, seed);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Graph graph = createGraphWithGenerator(0, n, sigma, &generator);
+    double serial = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CSRGraph csr = createCSRGraph(0, n, sigma, graph.xCoordinates, graph.yCoordinates, 0);
+    double serialCsr = elapsedSeconds(start);
+    printf("%d vertices, %ld processors, serial : createGraph %.3lf s, createCSRGraph %.3lf s\n",
+           n, sysconf(_SC_NPROCESSORS_ONLN), serial, serialCsr);
+    for (int k = 0; k < 4; k++){
+        rngSeed(&generator, seed);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        Graph parallel = createGraphParallel(0, n, sigma, nbThreads[k], &generator);
+        double t = elapsedSeconds(start);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        CSRGraph parallelCsr = createCSRGraphParallel(0, n, sigma, graph.xCoordinates, graph.yCoordinates, 0, nbThreads[k]);
+        double tCsr = elapsedSeconds(start);
+        printf("%d threads : createGraphParallel %.3lf s (speedup %.2lf), createCSRGraphParallel %.3lf s (speedup %.2lf), %s\n",
+               nbThreads[k], t, serial/t, tCsr, serialCsr/tCsr,
+               sameLists(graph, parallel) && sameCSRGraphs(csr, parallelCsr) ? "same graphs" : "DIFFERENT graphs");
+        freeCSRGraph(&parallelCsr);
+        freeGraph(parallel);
+    }
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test parallel generation ----\n");
+}
+
+/**
+ * @brief Compares the kernels of pointsWithinDistance with a loop testing distance() and measures their throughput
+ */
+void testDistanceKernel(){
+    printf("---- Test distance kernels ----\n");
+    const char *names[3] = {"scalar", "SSE2", "AVX2"};
+    int n = 4096;
+    double sigma = 0.1;
+    double *xs = malloc(sizeof(double)*n);
+    double *ys = malloc(sizeof(double)*n);
+    int *indices = malloc(sizeof(int)*n);
+    int *expected = malloc(sizeof(int)*n);
+    for (int i = 0; i<n; i++){
+        xs[i] = (double)rand()/RAND_MAX;
+        ys[i] = (double)rand()/RAND_MAX;
+    }
+    /* points on the circle of radius sigma around the first point */
+    for (int i = 1; i<64; i++){
+        xs[i] = xs[0] + ((i & 1) ? sigma : -sigma);
+        ys[i] = ys[0];
+    }
+    xs[64] = xs[0] + sigma*0.6; ys[64] = ys[0] + sigma*0.8;
+    for (int kernel = DISTANCE_KERNEL_SCALAR; kernel <= DISTANCE_KERNEL_AVX2; kernel++){
+        DistanceKernel used = selectDistanceKernel(kernel);
+        if ((int)used != kernel){
+            printf("%s : not supported by the processor\n", names[kernel]);
+            continue;
+        }
+        int same = 1;
+        for (int inclusive = 0; inclusive < 2; inclusive++){
+            for (int i = 0; i<n && same; i+=37){
+                /* odd bounds to test the remainders of the vector loops */
+                int begin = i % 5, end = n - i % 3;
+                int nbExpected = 0;
+                for (int j = begin; j<end; j++){
+                    double d = distance(xs[i], ys[i], xs[j], ys[j]);
+                    if (d < sigma || (inclusive && d == sigma))
+                        expected[nbExpected++] = j;
+                }
+                int nb = pointsWithinDistance(xs[i], ys[i], xs, ys, begin, end, sigma, inclusive, indices);
+                if (nb != nbExpected)
+                    same = 0;
+                for (int j = 0; j<nb && same; j++){
+                    if (indices[j] != expected[j])
+                        same = 0;
+                }
+            }
+        }
+        int repetitions = 2000;
+        long found = 0;
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int r = 0; r<repetitions; r++){
+            found += pointsWithinDistance(xs[r % n], ys[r % n], xs, ys, 0, n, sigma, 0, indices);
+        }
+        double t = elapsedSeconds(start);
+        printf("%s : %s points as distance(), %.1lf Mpoints/s (%ld found)\n", names[kernel],
+               same ? "same" : "DIFFERENT", (double)repetitions*n/t/1e6, found);
+    }
+    selectDistanceKernel(DISTANCE_KERNEL_AVX2);
+    free(xs);
+    free(ys);
+    free(indices);
+    free(expected);
+    printf("---- Fin test distance kernels ----\n");
+}
 
 int main() {
     srand(time(NULL));
@@ -44,5 +974,16 @@ int main() {
     printConsoleGraph(graph);
     drawGraph(graph, "components-graph-tree.svg",2,0);
     drawGraph(graph, "components-tree.svg",1,0);
+
+    testCSRGraph();
+    testGridGeneration();
+    testDistanceKernel();
+    testParallelGeneration();
+    testGraphFile();
+    testDrawGraph();
+    testDirectionOptimizingBFS();
+    testConnectedComponents();
+    testIncrementalConnectivity();
+    testIncomingEdges();
     return 0;
 }
@@ -0,0 +1,334 @@
+/**
+ * @file concurrenthashtable.c
+ * @brief Source file for a hash table that can be used by several threads
+ *
+ * This file contains the implementation of the concurrent hash table.
+ *
+ * Writers lock the segment of the key. Readers take no lock: a cell is fully
+ * initialized before being published with a release store, and the readers
+ * load the pointers with acquire loads. A removed cell is unlinked but its
+ * field nextCell is kept, so a reader standing on it can go on. When a segment
+ * grows, its cells are copied in a new table of lists which is then published;
+ * the readers still using the previous table see a consistent snapshot of it.
+ * The memory that readers may still use is retired and freed by
+ * concurrentHashtableReclaim or concurrentHashtableDestroy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "concurrenthashtable.h"
+#include "hashtable.h"
+
+/**
+ * @brief Returns the smallest power of two greater or equal to n
+ */
+static size_t roundPowerOfTwo(size_t n){
+    size_t size = 1;
+    while (size < n){
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * @brief Returns a new table of sizeTable empty lists
+ */
+static ConcurrentBuckets* createBuckets(size_t sizeTable){
+    ConcurrentBuckets *buckets = malloc(sizeof(ConcurrentBuckets));
+    buckets->sizeTable = sizeTable;
+    buckets->table = malloc(sizeof(ConcurrentCell * _Atomic)*sizeTable);
+    for (size_t i = 0; i < sizeTable; i++){
+        atomic_init(&buckets->table[i], NULL);
+    }
+    return buckets;
+}
+
+/**
+ * @brief Adds a memory block to the retired memory of a segment (the lock of the segment is held)
+ */
+static void retire(ConcurrentSegment *segment, void *pointer){
+    Retired *retired = malloc(sizeof(Retired));
+    retired->pointer = pointer;
+    retired->next = segment->retired;
+    segment->retired = retired;
+}
+
+/**
+ * @brief Returns the segment of a hash
+ */
+static ConcurrentSegment* segmentOf(ConcurrentHashTable *hashtable, uint32_t hash){
+    return &hashtable->segments[(uint64_t) hash >> hashtable->segmentShift];
+}
+
+/**
+ * @brief Lock-free search of a key in a table of lists, returns its cell or NULL
+ */
+static ConcurrentCell* findCell(ConcurrentBuckets *buckets, string key, uint32_t hash){
+    ConcurrentCell *cell = atomic_load_explicit(&buckets->table[hash & (buckets->sizeTable - 1)],
+                                                memory_order_acquire);
+    while (cell != NULL){
+        if (cell->hash == hash && strcmp(cell->key, key) == 0){
+            return cell;
+        }
+        cell = atomic_load_explicit(&cell->nextCell, memory_order_acquire);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Doubles the number of lists of a segment (the lock of the segment is held)
+ *
+ * The cells are copied, the keys are shared by the copies. The previous table
+ * and the previous cells are retired.
+ */
+static void growSegment(ConcurrentSegment *segment){
+    ConcurrentBuckets *old = atomic_load_explicit(&segment->buckets, memory_order_relaxed);
+    ConcurrentBuckets *buckets = createBuckets(2*old->sizeTable);
+    size_t mask = buckets->sizeTable - 1;
+    for (size_t i = 0; i < old->sizeTable; i++){
+        ConcurrentCell *cell = atomic_load_explicit(&old->table[i], memory_order_relaxed);
+        while (cell != NULL){
+            ConcurrentCell *copy = malloc(sizeof(ConcurrentCell));
+            copy->key = cell->key;
+            copy->hash = cell->hash;
+            atomic_init(&copy->value, atomic_load_explicit(&cell->value, memory_order_relaxed));
+            atomic_init(&copy->nextCell, atomic_load_explicit(&buckets->table[cell->hash & mask], memory_order_relaxed));
+            atomic_store_explicit(&buckets->table[cell->hash & mask], copy, memory_order_relaxed);
+            ConcurrentCell *next = atomic_load_explicit(&cell->nextCell, memory_order_relaxed);
+            retire(segment, cell);
+            cell = next;
+        }
+    }
+    /* the new table is complete before being visible to the readers */
+    atomic_store_explicit(&segment->buckets, buckets, memory_order_release);
+    retire(segment, old->table);
+    retire(segment, old);
+}
+
+/**
+ * @brief Adds delta to the value of the key, or sets it to value if replace!=0.
+ * Inserts the key if necessary and returns the new value.
+ */
+static int updateValue(ConcurrentHashTable *hashtable, string key, int value, int replace){
+    uint32_t hash = murmurhash32(key, strlen(key));
+    ConcurrentSegment *segment = segmentOf(hashtable, hash);
+    pthread_mutex_lock(&segment->lock);
+    ConcurrentBuckets *buckets = atomic_load_explicit(&segment->buckets, memory_order_relaxed);
+    ConcurrentCell *cell = findCell(buckets, key, hash);
+    int newValue;
+    if (cell != NULL){
+        newValue = replace ? value : atomic_load_explicit(&cell->value, memory_order_relaxed) + value;
+        atomic_store_explicit(&cell->value, newValue, memory_order_relaxed);
+    }
+    else {
+        ConcurrentCell * _Atomic *bucket = &buckets->table[hash & (buckets->sizeTable - 1)];
+        cell = malloc(sizeof(ConcurrentCell));
+        cell->key = malloc(strlen(key)+1);
+        strcpy(cell->key, key);
+        cell->hash = hash;
+        atomic_init(&cell->value, value);
+        atomic_init(&cell->nextCell, atomic_load_explicit(bucket, memory_order_relaxed));
+        /* publication of the initialized cell */
+        atomic_store_explicit(bucket, cell, memory_order_release);
+        newValue = value;
+        segment->numberOfPairs += 1;
+        if (segment->numberOfPairs > buckets->sizeTable){
+            growSegment(segment);
+        }
+    }
+    pthread_mutex_unlock(&segment->lock);
+    return newValue;
+}
+
+
+/**
+ * Create a new concurrent hash table.
+ *
+ * @param nbSegments the number of segments (i.e. of locks), rounded up to a power of two
+ * @param sizeTable the initial number of lists of each segment, rounded up to a power of two
+ * @return a pointer on the new hash table
+ */
+ConcurrentHashTable* concurrentHashtableCreate(size_t nbSegments, size_t sizeTable){
+    ConcurrentHashTable *hashtable = malloc(sizeof(ConcurrentHashTable));
+    hashtable->nbSegments = roundPowerOfTwo(nbSegments);
+    unsigned int bits = 0;
+    while (((size_t) 1 << bits) < hashtable->nbSegments){
+        bits++;
+    }
+    hashtable->segmentShift = 32 - bits;
+    hashtable->segments = malloc(sizeof(ConcurrentSegment)*hashtable->nbSegments);
+    for (size_t i = 0; i < hashtable->nbSegments; i++){
+        ConcurrentSegment *segment = &hashtable->segments[i];
+        pthread_mutex_init(&segment->lock, NULL);
+        atomic_init(&segment->buckets, createBuckets(roundPowerOfTwo(sizeTable)));
+        segment->numberOfPairs = 0;
+        segment->retired = NULL;
+    }
+    return hashtable;
+}
+
+
+/**
+ * Quiescent point: frees the cells removed from the table and the tables of
+ * lists replaced by a resize. No other thread may use the table during the call.
+ *
+ * @param hashtable the hash table
+ */
+void concurrentHashtableReclaim(ConcurrentHashTable *hashtable){
+    for (size_t i = 0; i < hashtable->nbSegments; i++){
+        ConcurrentSegment *segment = &hashtable->segments[i];
+        while (segment->retired != NULL){
+            Retired *next = segment->retired->next;
+            free(segment->retired->pointer);
+            free(segment->retired);
+            segment->retired = next;
+        }
+    }
+}
+
+
+/**
+ * Free all the memory used by a concurrent hash table, including the data
+ * structure itself. No other thread may use the table during and after the call.
+ *
+ * @param hashtable the hash table to free
+ */
+void concurrentHashtableDestroy(ConcurrentHashTable *hashtable){
+    concurrentHashtableReclaim(hashtable);
+    for (size_t i = 0; i < hashtable->nbSegments; i++){
+        ConcurrentSegment *segment = &hashtable->segments[i];
+        ConcurrentBuckets *buckets = atomic_load(&segment->buckets);
+        for (size_t j = 0; j < buckets->sizeTable; j++){
+            ConcurrentCell *cell = atomic_load(&buckets->table[j]);
+            while (cell != NULL){
+                ConcurrentCell *next = atomic_load(&cell->nextCell);
+                free(cell->key);
+                free(cell);
+                cell = next;
+            }
+        }
+        free(buckets->table);
+        free(buckets);
+        pthread_mutex_destroy(&segment->lock);
+    }
+    free(hashtable->segments);
+    free(hashtable);
+}
+
+
+/**
+ * Insert a new key-value pair into the hash table. If the key is
+ * already in the hash table, the old value is replaced by the input value.
+ * The segment of the key grows if necessary, the other segments stay available.
+ *
+ * @param hashtable the hash table to insert into
+ * @param key the key for the new pair
+ * @param value the value for the new pair
+ */
+void concurrentHashtableInsert(ConcurrentHashTable *hashtable, string key, int value){
+    updateValue(hashtable, key, value, 1);
+}
+
+
+/**
+ * Add a value to the value associated with a key. If the key is not
+ * in the hash table, the pair (key, delta) is inserted.
+ *
+ * @param hashtable the hash table
+ * @param key the key
+ * @param delta the value to add
+ * @return the new value associated to the key
+ */
+int concurrentHashtableAdd(ConcurrentHashTable *hashtable, string key, int delta){
+    return updateValue(hashtable, key, delta, 0);
+}
+
+
+/**
+ * Test if a key is in the hash table. This function takes no lock.
+ *
+ * @param hashtable the hash table to search in
+ * @param key the key to search for
+ * @return 1 if the key is in the table, 0 otherwise.
+ */
+int concurrentHashtableHasKey(ConcurrentHashTable *hashtable, string key){
+    int value;
+    return concurrentHashtableGetValue(hashtable, key, &value);
+}
+
+
+/**
+ * Get the value associated with the given key. This function takes no lock.
+ *
+ * @param hashtable the hash table to search in
+ * @param key the key to search for
+ * @param value pointer where the value is written if the key is found
+ * @return 1 if the key is in the table, 0 otherwise.
+ */
+int concurrentHashtableGetValue(ConcurrentHashTable *hashtable, string key, int *value){
+    uint32_t hash = murmurhash32(key, strlen(key));
+    ConcurrentSegment *segment = segmentOf(hashtable, hash);
+    ConcurrentBuckets *buckets = atomic_load_explicit(&segment->buckets, memory_order_acquire);
+    ConcurrentCell *cell = findCell(buckets, key, hash);
+    if (cell == NULL){
+        return 0;
+    }
+    *value = atomic_load_explicit(&cell->value, memory_order_relaxed);
+    return 1;
+}
+
+
+/**
+ * Remove the key-value pair with the given key from the hash table.
+ * The cell is freed at the next quiescent point.
+ *
+ * @param hashtable the hash table to remove from
+ * @param key the key of the pair to remove
+ * @return 0 if the key was not in the hash table, 1 otherwise
+ */
+int concurrentHashtableRemove(ConcurrentHashTable *hashtable, string key){
+    uint32_t hash = murmurhash32(key, strlen(key));
+    ConcurrentSegment *segment = segmentOf(hashtable, hash);
+    pthread_mutex_lock(&segment->lock);
+    ConcurrentBuckets *buckets = atomic_load_explicit(&segment->buckets, memory_order_relaxed);
+    ConcurrentCell * _Atomic *link = &buckets->table[hash & (buckets->sizeTable - 1)];
+    ConcurrentCell *cell = atomic_load_explicit(link, memory_order_relaxed);
+    while (cell != NULL && (cell->hash != hash || strcmp(cell->key, key) != 0)){
+        link = &cell->nextCell;
+        cell = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    if (cell == NULL){
+        pthread_mutex_unlock(&segment->lock);
+        return 0;
+    }
+    /* the removed cell keeps its field nextCell for the readers standing on it */
+    atomic_store_explicit(link, atomic_load_explicit(&cell->nextCell, memory_order_relaxed),
+                          memory_order_release);
+    segment->numberOfPairs -= 1;
+    retire(segment, cell->key);
+    retire(segment, cell);
+    pthread_mutex_unlock(&segment->lock);
+    return 1;
+}
+
+
+/**
+ * Returns the number of pairs in the hash table. The result is exact
+ * only if no other thread modifies the table.
+ *
+ * @param hashtable the hash table
+ * @return the number of pairs
+ */
+size_t concurrentHashtableNumberOfPairs(ConcurrentHashTable *hashtable){
+    size_t numberOfPairs = 0;
+    for (size_t i = 0; i < hashtable->nbSegments; i++){
+        ConcurrentSegment *segment = &hashtable->segments[i];
+        pthread_mutex_lock(&segment->lock);
+        numberOfPairs += segment->numberOfPairs;
+        pthread_mutex_unlock(&segment->lock);
+    }
+    return numberOfPairs;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file concurrenthashtable.h
+ * @brief Header file for a hash table that can be used by several threads
+ *
+ * This file contains the declaration of a concurrent hash table and its
+ * associated functions. The table is split in segments, each segment being
+ * a table of linked lists protected by its own lock for the writers.
+ * The readers take no lock: they follow atomic pointers, and the cells
+ * removed from the table are only freed at quiescent points.
+ */
+
+#ifndef CONCURRENTHASHTABLE_H_INCLUDED
+#define CONCURRENTHASHTABLE_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "../list/list.h"
+
+/**
+ * @brief Definition of a cell of a concurrent hash table
+ *
+ * The key and its hash never change once the cell is in the table.
+ */
+typedef struct concurrentCell{
+    string key; /**< Key of the cell */
+    _Atomic int value; /**< Value of the cell */
+    uint32_t hash; /**< Full hash of the key */
+    struct concurrentCell * _Atomic nextCell; /**< Pointer to the next cell in the bucket */
+} ConcurrentCell;
+
+/**
+ * @brief Table of lists of a segment
+ *
+ * When a segment grows, a new table of lists is built and published, the
+ * previous one stays readable until the next quiescent point.
+ */
+typedef struct concurrentBuckets{
+    size_t sizeTable; /**< Number of lists, a power of two */
+    ConcurrentCell * _Atomic *table; /**< Table of lists */
+} ConcurrentBuckets;
+
+/**
+ * @brief Memory waiting for a quiescent point to be freed
+ */
+typedef struct retired{
+    void *pointer; /**< Memory to free */
+    struct retired *next; /**< Next retired memory */
+} Retired;
+
+/**
+ * @brief Segment of a concurrent hash table
+ */
+typedef struct concurrentSegment{
+    pthread_mutex_t lock; /**< Lock of the writers of the segment */
+    ConcurrentBuckets * _Atomic buckets; /**< Current table of lists of the segment */
+    size_t numberOfPairs; /**< Number of pairs in the segment */
+    Retired *retired; /**< Memory removed from the segment and not freed yet */
+} ConcurrentSegment;
+
+/**
+ * @brief Definition of a concurrent hash table
+ *
+ * The segment of a key is given by the highest bits of its hash
+ * and its list in the segment by the lowest bits.
+ */
+typedef struct concurrentHashtable{
+    size_t nbSegments; /**< Number of segments, a power of two */
+    unsigned int segmentShift; /**< 32 - log2(nbSegments) */
+    ConcurrentSegment *segments; /**< Array of segments */
+} ConcurrentHashTable;
+
+
+/**
+ * Create a new concurrent hash table.
+ *
+ * @param nbSegments the number of segments (i.e. of locks), rounded up to a power of two
+ * @param sizeTable the initial number of lists of each segment, rounded up to a power of two
+ * @return a pointer on the new hash table
+ */
+ConcurrentHashTable* concurrentHashtableCreate(size_t nbSegments, size_t sizeTable);
+
+/**
+ * Free all the memory used by a concurrent hash table, including the data
+ * structure itself. No other thread may use the table during and after the call.
+ *
+ * @param hashtable the hash table to free
+ */
+void concurrentHashtableDestroy(ConcurrentHashTable *hashtable);
+
+/**
+ * Insert a new key-value pair into the hash table. If the key is
+ * already in the hash table, the old value is replaced by the input value.
+ * The segment of the key grows if necessary, the other segments stay available.
+ *
+ * @param hashtable the hash table to insert into
+ * @param key the key for the new pair
+ * @param value the value for the new pair
+ */
+void concurrentHashtableInsert(ConcurrentHashTable *hashtable, string key, int value);
+
+/**
+ * Add a value to the value associated with a key. If the key is not
+ * in the hash table, the pair (key, delta) is inserted.
+ *
+ * @param hashtable the hash table
+ * @param key the key
+ * @param delta the value to add
+ * @return the new value associated to the key
+ */
+int concurrentHashtableAdd(ConcurrentHashTable *hashtable, string key, int delta);
+
+/**
+ * Test if a key is in the hash table. This function takes no lock.
+ *
+ * @param hashtable the hash table to search in
+ * @param key the key to search for
+ * @return 1 if the key is in the table, 0 otherwise.
+ */
+int concurrentHashtableHasKey(ConcurrentHashTable *hashtable, string key);
+
+/**
+ * Get the value associated with the given key. This function takes no lock.
+ *
+ * @param hashtable the hash table to search in
+ * @param key the key to search for
+ * @param value pointer where the value is written if the key is found
+ * @return 1 if the key is in the table, 0 otherwise.
+ */
+int concurrentHashtableGetValue(ConcurrentHashTable *hashtable, string key, int *value);
+
+/**
+ * Remove the key-value pair with the given key from the hash table.
+ * The cell is freed at the next quiescent point.
+ *
+ * @param hashtable the hash table to remove from
+ * @param key the key of the pair to remove
+ * @return 0 if the key was not in the hash table, 1 otherwise
+ */
+int concurrentHashtableRemove(ConcurrentHashTable *hashtable, string key);
+
+/**
+ * Returns the number of pairs in the hash table. The result is exact
+ * only if no other thread modifies the table.
+ *
+ * @param hashtable the hash table
+ * @return the number of pairs
+ */
+size_t concurrentHashtableNumberOfPairs(ConcurrentHashTable *hashtable);
+
+/**
+ * Quiescent point: frees the cells removed from the table and the tables of
+ * lists replaced by a resize. No other thread may use the table during the call.
+ *
+ * @param hashtable the hash table
+ */
+void concurrentHashtableReclaim(ConcurrentHashTable *hashtable);
+
+#endif // CONCURRENTHASHTABLE_H_INCLUDED
@@ -14,6 +14,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
 
 #include "hashtable.h"
 #include "../list/list.h"
@@ -24,15 +29,13 @@
 #define ROTL32(x,y)    ((x << y) | (x >> (32 - y)))
 
  /**
- * @brief Hash function murmurhash
+ * @brief Hash function murmurhash without the final reduction
  *
  * @param key string representing the key to hash
  * @param sizeKey length of the string key
- * @param maxValue maximum value (excluded) that must return the hash function
- * @return the hash code of the key between 0 and maxValue-1
+ * @return the full 32-bit hash code of the key
  */
-
-size_t murmurhash(string key, size_t sizeKey, size_t maxValue)
+uint32_t murmurhash32(string key, size_t sizeKey)
 {
     const uint32_t c1 = 0xcc9e2d51;
     const uint32_t c2 = 0x1b873593;
@@ -44,7 +47,8 @@ size_t murmurhash(string key, size_t sizeKey, size_t maxValue)
     uint32_t k = 0;
 
     for (size_t i = 0; i < sizeKey / 4; i++) {
-        k = ((uint32_t *)key)[i];
+        /* memcpy avoids the unaligned access, compiled as a single load */
+        memcpy(&k, key + 4*i, 4);
         k *= c1;
         k = ROTL32(k, r1);
         k *= c2;
@@ -78,7 +82,454 @@ size_t murmurhash(string key, size_t sizeKey, size_t maxValue)
     hash *= 0xc2b2ae35;
     hash ^= hash >> 16;
 
-    return hash % maxValue;
+    return hash;
+}
+
+/**
+ * @brief Reads 8 bytes of a key, whatever its alignment
+ */
+static inline uint64_t read64(const char *p){
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+/**
+ * @brief Reads 4 bytes of a key, whatever its alignment
+ */
+static inline uint64_t read32(const char *p){
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/**
+ * @brief Multiplies two 64-bit words and folds the 128-bit product in 64 bits
+ */
+static inline uint64_t mix64(uint64_t a, uint64_t b){
+    __uint128_t product = (__uint128_t) a * b;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+}
+
+/**
+ * @brief Hash function in the style of wyhash, 16 bytes per step
+ *
+ * @param key string representing the key to hash
+ * @param sizeKey length of the string key
+ * @return the 64-bit hash code of the key
+ */
+uint64_t widehash64(string key, size_t sizeKey)
+{
+    const uint64_t s0 = 0xa0761d6478bd642full;
+    const uint64_t s1 = 0xe7037ed1a0b428dbull;
+    const uint64_t s2 = 0x8ebc6af09c88c6e3ull;
+    const char *p = key;
+    uint64_t seed = s0 ^ mix64(sizeKey ^ s0, s1);
+    uint64_t a, b;
+    if (sizeKey <= 16) {
+        if (sizeKey >= 4) {
+            /* two overlapping reads of 4 bytes at each end */
+            a = (read32(p) << 32) | read32(p + ((sizeKey >> 3) << 2));
+            b = (read32(p + sizeKey - 4) << 32) | read32(p + sizeKey - 4 - ((sizeKey >> 3) << 2));
+        }
+        else if (sizeKey > 0) {
+            a = ((uint64_t)(uint8_t) p[0] << 16) | ((uint64_t)(uint8_t) p[sizeKey >> 1] << 8) | (uint8_t) p[sizeKey - 1];
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = sizeKey;
+        while (i > 16) {
+            seed = mix64(read64(p) ^ s1, read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        /* the last 16 bytes of the key, possibly overlapping the previous step */
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    return mix64(s1 ^ sizeKey, mix64(a ^ s1, b ^ seed) ^ s2);
+}
+
+/**
+ * @brief Hash function widehash64 folded in 32 bits, usable as a HashFunction
+ *
+ * @param key string representing the key to hash
+ * @param sizeKey length of the string key
+ * @return the 32-bit hash code of the key
+ */
+uint32_t widehash32(string key, size_t sizeKey)
+{
+    uint64_t hash = widehash64(key, sizeKey);
+    return (uint32_t) (hash ^ (hash >> 32));
+}
+
+/**
+ * @brief Hash function murmurhash
+ *
+ * @param key string representing the key to hash
+ * @param sizeKey length of the string key
+ * @param maxValue maximum value (excluded) that must return the hash function
+ * @return the hash code of the key between 0 and maxValue-1
+ */
+
+size_t murmurhash(string key, size_t sizeKey, size_t maxValue)
+{
+    return murmurhash32(key, sizeKey) % maxValue;
+}
+
+/**
+ * @brief Hashes a key (of length sizeKey) with the hash function of a table
+ */
+static inline uint32_t hashKey(const HashTable *hashtable, const char *key, size_t sizeKey){
+    return hashtable->hashFunction((string) key, sizeKey);
+}
+
+/**
+ * @brief Returns the list of a hash in a table of sizeTable lists,
+ * with a mask if sizeTable is a power of two, with a modulo otherwise
+ */
+static inline size_t reduceHash(uint32_t hash, size_t sizeTable, int powerOfTwo){
+    return powerOfTwo ? (hash & (sizeTable - 1)) : hash % sizeTable;
+}
+
+
+/*
+ * Open addressing engine (HASHTABLE_OPEN_ADDRESSING).
+ *
+ * The pairs are stored in a flat array of slots whose size is a power of two,
+ * so the home slot of a key is hash & (sizeTable-1). Collisions are resolved
+ * by linear probing with the Robin Hood rule: a key that is far from its home
+ * slot takes the place of a key that is closer to its own home slot. The
+ * probe sequences stay short and a search can stop as soon as it meets a slot
+ * whose probe distance is smaller than the current one.
+ */
+
+ /**
+ * @brief Maximal load factor of an open addressing table (numerator / 8)
+ */
+#define OPEN_MAX_LOAD 7
+
+/**
+ * @brief Returns the smallest power of two greater or equal to n (and to 8)
+ */
+static size_t openRoundSize(size_t n){
+    size_t size = 8;
+    while (size < n){
+        size *= 2;
+    }
+    return size;
+}
+
+/**
+ * @brief Returns 1 if the string cellKey is equal to the sizeKey first characters of key
+ *
+ * key does not need to be null-terminated.
+ */
+static int keyEquals(string cellKey, const char *key, size_t sizeKey){
+    return strncmp(cellKey, key, sizeKey) == 0 && cellKey[sizeKey] == '\0';
+}
+
+/**
+ * @brief Returns the index of the slot containing the key (of length sizeKey), or -1 if the key is not in the table
+ */
+static long openFindSlot(HashTable hashtable, const char *key, size_t sizeKey, uint32_t hash){
+    if (hashtable.sizeTable == 0){
+        return -1;
+    }
+    HashTableStats *stats = hashtable.stats;
+    if (stats){
+        stats->lookups++;
+    }
+    size_t mask = hashtable.sizeTable - 1;
+    size_t i = hash & mask;
+    uint32_t probe = 0;
+    while (1){
+        Slot *slot = &hashtable.slots[i];
+        if (slot->key == NULL || slot->probe < probe || probe > mask){
+            return -1;
+        }
+        if (stats){
+            stats->cellsVisited++;
+        }
+        if (slot->hash == hash){
+            if (stats){
+                stats->keyComparisons++;
+            }
+            if (keyEquals(slot->key, key, sizeKey)){
+                return (long) i;
+            }
+        }
+        i = (i + 1) & mask;
+        probe++;
+    }
+}
+
+/**
+ * @brief Places a pair whose key is not in the table. The key is not copied.
+ *
+ * The table is supposed to contain at least one empty slot.
+ * Returns the index of the slot where the pair is placed.
+ */
+static size_t openPlace(HashTable *hashtable, string key, int value, uint32_t hash){
+    size_t mask = hashtable->sizeTable - 1;
+    size_t i = hash & mask;
+    size_t placed = hashtable->sizeTable;
+    Slot current;
+    current.key = key;
+    current.value = value;
+    current.hash = hash;
+    current.probe = 0;
+    while (hashtable->slots[i].key != NULL){
+        if (hashtable->slots[i].probe < current.probe){
+            Slot tmp = hashtable->slots[i];
+            hashtable->slots[i] = current;
+            current = tmp;
+            if (placed == hashtable->sizeTable){
+                placed = i;
+            }
+        }
+        i = (i + 1) & mask;
+        current.probe++;
+    }
+    hashtable->slots[i] = current;
+    hashtable->numberOfPairs += 1;
+    return placed == hashtable->sizeTable ? i : placed;
+}
+
+/**
+ * @brief Moves all the pairs of an open addressing table into a table of the given size
+ *
+ * The keys and their hash are moved, not copied nor recomputed.
+ */
+static void openResize(HashTable *hashtable, size_t newSize){
+    HashTable newHashtable = hashtableCreateWithEngine(newSize, HASHTABLE_OPEN_ADDRESSING);
+    for (size_t i = 0; i < hashtable->sizeTable; i++){
+        Slot *slot = &hashtable->slots[i];
+        if (slot->key != NULL){
+            openPlace(&newHashtable, slot->key, slot->value, slot->hash);
+        }
+    }
+    free(hashtable->slots);
+    hashtable->slots = newHashtable.slots;
+    hashtable->sizeTable = newHashtable.sizeTable;
+}
+
+/**
+ * @brief Returns the index of the slot of the key (of length sizeKey) in an open addressing table. If the key
+ * is not in the table, the pair (key,value) is inserted and *inserted is set to 1.
+ * The table grows if grow!=0. Returns -1 if the table is full.
+ */
+static long openGetOrInsert(HashTable *hashtable, const char *key, size_t sizeKey, int value, int grow, int *inserted){
+    uint32_t hash = hashKey(hashtable, key, sizeKey);
+    long index = openFindSlot(*hashtable, key, sizeKey, hash);
+    *inserted = 0;
+    if (index >= 0){
+        return index;
+    }
+    if (grow && (hashtable->numberOfPairs + 1) * 8 > hashtable->sizeTable * OPEN_MAX_LOAD){
+        openResize(hashtable, hashtable->sizeTable == 0 ? 8 : 2 * hashtable->sizeTable);
+    }
+    if (hashtable->numberOfPairs >= hashtable->sizeTable){
+        printf("the open addressing hashtable is full : error for hashtableInsertWithoutResizing\n");
+        return -1;
+    }
+    string copy;
+    if (hashtable->arena){
+        copy = arenaCopyKey(hashtable->arena, key, sizeKey);
+    }
+    else {
+        copy = malloc(sizeKey + 1);
+        memcpy(copy, key, sizeKey);
+        copy[sizeKey] = '\0';
+    }
+    *inserted = 1;
+    return (long) openPlace(hashtable, copy, value, hash);
+}
+
+/**
+ * @brief Insertion in an open addressing table, the table grows if grow!=0
+ */
+static void openInsert(HashTable *hashtable, string key, int value, int grow){
+    int inserted;
+    long index = openGetOrInsert(hashtable, key, strlen(key), value, grow, &inserted);
+    if (index >= 0 && !inserted){
+        hashtable->slots[index].value = value;
+    }
+}
+
+/**
+ * @brief Removal in an open addressing table with backward shift deletion
+ */
+static int openRemove(HashTable *hashtable, string key){
+    long index = openFindSlot(*hashtable, key, strlen(key), hashKey(hashtable, key, strlen(key)));
+    if (index < 0){
+        return 0;
+    }
+    size_t mask = hashtable->sizeTable - 1;
+    size_t i = (size_t) index;
+    if (hashtable->arena == NULL){
+        free(hashtable->slots[i].key);
+    }
+    size_t next = (i + 1) & mask;
+    /* shift back the following keys until an empty slot or a key at its home slot */
+    while (hashtable->slots[next].key != NULL && hashtable->slots[next].probe > 0){
+        hashtable->slots[i] = hashtable->slots[next];
+        hashtable->slots[i].probe--;
+        i = next;
+        next = (next + 1) & mask;
+    }
+    hashtable->slots[i].key = NULL;
+    hashtable->slots[i].probe = 0;
+    hashtable->numberOfPairs -= 1;
+    return 1;
+}
+
+
+/*
+ * Searches in the chaining engine.
+ *
+ * The cells of a hash table cache the full hash of their key, so a search
+ * compares the hashes first and calls strcmp only when they are equal.
+ */
+
+/**
+ * @brief Returns the address of the link (bucket or field nextCell) pointing on the cell
+ * of the key (of length sizeKey) in a bucket, or NULL if the key is not in the bucket
+ */
+static Cell** findLinkInBucket(List *bucket, const char *key, size_t sizeKey, uint32_t hash, HashTableStats *stats){
+    if (stats){
+        stats->lookups++;
+    }
+    Cell** link = bucket;
+    while (*link != NULL){
+        if (stats){
+            stats->cellsVisited++;
+        }
+        if ((*link)->hash == hash){
+            if (stats){
+                stats->keyComparisons++;
+            }
+            if (keyEquals((*link)->key, key, sizeKey)){
+                return link;
+            }
+        }
+        link = &(*link)->nextCell;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns the cell of the key in a bucket, NULL if the key is not in the bucket
+ */
+static Cell* findKeyInBucket(List bucket, const char *key, size_t sizeKey, uint32_t hash, HashTableStats *stats){
+    Cell** link = findLinkInBucket(&bucket, key, sizeKey, hash, stats);
+    return link ? *link : NULL;
+}
+
+
+/*
+ * Incremental resize of the chaining engine.
+ *
+ * During a migration, a key is either in [table] or in a bucket of [oldTable]
+ * that is not moved yet. New keys are always added in [table].
+ */
+
+/**
+ * @brief Returns the cell of the key in the buckets of oldTable that are not moved yet, NULL otherwise
+ */
+static Cell** findLinkInOldTable(HashTable hashtable, const char *key, size_t sizeKey, uint32_t hash){
+    if (hashtable.oldTable == NULL){
+        return NULL;
+    }
+    size_t hache = reduceHash(hash, hashtable.oldSizeTable, hashtable.powerOfTwo);
+    if (hache < hashtable.migrationIndex){
+        return NULL;
+    }
+    return findLinkInBucket(&hashtable.oldTable[hache], key, sizeKey, hash, hashtable.stats);
+}
+
+/**
+ * @brief Returns the cell of the key in a chaining hash table, NULL if the key is not in the table
+ */
+static Cell* findKeyInTable(HashTable hashtable, string key){
+    if (hashtable.table == NULL){
+        return NULL;
+    }
+    size_t sizeKey = strlen(key);
+    uint32_t hash = hashKey(&hashtable, key, sizeKey);
+    Cell* cell = findKeyInBucket(hashtable.table[reduceHash(hash, hashtable.sizeTable, hashtable.powerOfTwo)], key, sizeKey, hash, hashtable.stats);
+    if (cell == NULL){
+        Cell** link = findLinkInOldTable(hashtable, key, sizeKey, hash);
+        cell = link ? *link : NULL;
+    }
+    return cell;
+}
+
+/**
+ * @brief Moves the cells of a list at the head of their bucket in a table of lists.
+ *
+ * The cells are relinked, neither the cells nor the keys are copied, and
+ * the bucket is given by the hash cached in each cell.
+ */
+static void relinkList(List list, List *table, size_t sizeTable, int powerOfTwo){
+    while (list != NULL){
+        Cell* next = list->nextCell;
+        size_t hache = reduceHash(list->hash, sizeTable, powerOfTwo);
+        list->nextCell = table[hache];
+        table[hache] = list;
+        list = next;
+    }
+}
+
+/**
+ * @brief Moves at most nbBuckets buckets of oldTable in table. The cells are relinked, not copied.
+ */
+static void migrateBuckets(HashTable *hashtable, size_t nbBuckets){
+    while (hashtable->oldTable != NULL && nbBuckets > 0){
+        relinkList(hashtable->oldTable[hashtable->migrationIndex], hashtable->table, hashtable->sizeTable, hashtable->powerOfTwo);
+        hashtable->oldTable[hashtable->migrationIndex] = NULL;
+        hashtable->migrationIndex++;
+        nbBuckets--;
+        if (hashtable->migrationIndex == hashtable->oldSizeTable){
+            free(hashtable->oldTable);
+            hashtable->oldTable = NULL;
+            hashtable->oldSizeTable = 0;
+            hashtable->migrationIndex = 0;
+        }
+    }
+}
+
+/**
+ * @brief Doubles the size of a chaining hash table by relinking its cells in a new table of lists
+ */
+static void relinkDoubleSize(HashTable *hashtable){
+    HashTable newHashtable = hashtableCreate(2*hashtable->sizeTable);
+    for (size_t i = 0; i < hashtable->sizeTable; i++){
+        relinkList(hashtable->table[i], newHashtable.table, newHashtable.sizeTable, hashtable->powerOfTwo);
+    }
+    free(hashtable->table);
+    hashtable->table = newHashtable.table;
+    hashtable->sizeTable = newHashtable.sizeTable;
+}
+
+/**
+ * @brief Starts the migration of a chaining hash table towards a table of double size
+ */
+static void startMigration(HashTable *hashtable){
+    /* the previous migration is completed before starting a new one */
+    if (hashtable->oldTable != NULL){
+        migrateBuckets(hashtable, hashtable->oldSizeTable);
+    }
+    HashTable newHashtable = hashtableCreate(2*hashtable->sizeTable);
+    hashtable->oldTable = hashtable->table;
+    hashtable->oldSizeTable = hashtable->sizeTable;
+    hashtable->migrationIndex = 0;
+    hashtable->table = newHashtable.table;
+    hashtable->sizeTable = newHashtable.sizeTable;
 }
 
 
@@ -91,7 +542,17 @@ void hashtablePrint(HashTable hashtable) {
     printf("---Hash Table:\n");
     printf("Size: %zu\n", hashtable.sizeTable);
     printf("Number of Pairs: %zu\n", hashtable.numberOfPairs);
-    if(hashtable.table!=NULL){
+    if(hashtable.engine == HASHTABLE_OPEN_ADDRESSING && hashtable.slots!=NULL){
+        for (size_t i = 0; i < hashtable.sizeTable; i++) {
+            printf("%zu: ", i);
+            if (hashtable.slots[i].key != NULL)
+                printf("(%s,%d)", hashtable.slots[i].key, hashtable.slots[i].value);
+            else
+                printf("[]");
+            printf("\n");
+        }
+    }
+    else if(hashtable.table!=NULL){
         for (size_t i = 0; i < hashtable.sizeTable; i++) {
             printf("%zu: ", i);
             printList(hashtable.table[i],1);
@@ -100,6 +561,14 @@ void hashtablePrint(HashTable hashtable) {
     }
     else
         printf("NULL table\n");
+    if(hashtable.oldTable!=NULL){
+        printf("Buckets of the previous table not moved yet:\n");
+        for (size_t i = hashtable.migrationIndex; i < hashtable.oldSizeTable; i++) {
+            printf("%zu: ", i);
+            printList(hashtable.oldTable[i],1);
+            printf("\n");
+        }
+    }
     printf("---\n");
 }
 
@@ -112,10 +581,40 @@ void hashtablePrint(HashTable hashtable) {
  * @return an empty hash table with the convenient table size
  */
 HashTable hashtableCreate(size_t sizeTable) {
+    return hashtableCreateWithEngine(sizeTable, HASHTABLE_CHAINING);
+}
+
+
+/**
+ * Create a new hash table with the given size and storage engine.
+ * With HASHTABLE_OPEN_ADDRESSING, the size is rounded up to a power of two.
+ *
+ * @param sizeTable the size of the table
+ * @param engine the storage engine of the table
+ * @return an empty hash table with the convenient table size
+ */
+HashTable hashtableCreateWithEngine(size_t sizeTable, HashTableEngine engine) {
     HashTable hashtable;
     hashtable.sizeTable = sizeTable;
     hashtable.numberOfPairs = 0;
-    if (sizeTable <= 0){
+    hashtable.engine = engine;
+    hashtable.slots = NULL;
+    hashtable.oldTable = NULL;
+    hashtable.oldSizeTable = 0;
+    hashtable.migrationIndex = 0;
+    hashtable.migrationStep = 0;
+    hashtable.stats = NULL;
+    hashtable.arena = NULL;
+    hashtable.hashFunction = murmurhash32;
+    hashtable.powerOfTwo = 0;
+    if (engine == HASHTABLE_OPEN_ADDRESSING){
+        hashtable.table = NULL;
+        if (sizeTable > 0){
+            hashtable.sizeTable = openRoundSize(sizeTable);
+            hashtable.slots = calloc(hashtable.sizeTable, sizeof(Slot));
+        }
+    }
+    else if (sizeTable <= 0){
         hashtable.table = NULL;
     }
     else {
@@ -129,6 +628,76 @@ HashTable hashtableCreate(size_t sizeTable) {
 
 
 
+
+/**
+ * Create a new hash table with the given size, storage engine and hash function.
+ * The size is rounded up to a power of two, and the list (or the first slot)
+ * of a key is given by the lowest bits of its hash instead of a modulo.
+ *
+ * @param sizeTable the size of the table
+ * @param engine the storage engine of the table
+ * @param hashFunction the hash function of the keys, NULL for murmurhash32
+ * @return an empty hash table with the convenient table size
+ */
+HashTable hashtableCreateWithHash(size_t sizeTable, HashTableEngine engine, HashFunction hashFunction) {
+    HashTable hashtable = hashtableCreateWithEngine(engine == HASHTABLE_CHAINING ? openRoundSize(sizeTable) : sizeTable, engine);
+    hashtable.powerOfTwo = 1;
+    if (hashFunction){
+        hashtable.hashFunction = hashFunction;
+    }
+    return hashtable;
+}
+
+/**
+ * @brief Returns the cell of the key (of length sizeKey) in a chaining hash table. If the key is not
+ * in the table, the pair (key,value) is inserted without resizing the table and
+ * *inserted is set to 1.
+ */
+static Cell* chainingGetOrInsert(HashTable *hashtable, const char *key, size_t sizeKey, int value, int *inserted){
+    uint32_t hash = hashKey(hashtable, key, sizeKey);
+    size_t hache;
+    hache = reduceHash(hash, hashtable->sizeTable, hashtable->powerOfTwo);
+    Cell* cell = findKeyInBucket(hashtable->table[hache],key,sizeKey,hash,hashtable->stats);
+    if (cell == NULL){
+        Cell** link = findLinkInOldTable(*hashtable, key, sizeKey, hash);
+        cell = link ? *link : NULL;
+    }
+    *inserted = 0;
+    if (cell == NULL){
+        hashtable->table[hache] = addKeyValueInListArena(hashtable->table[hache],NULL,value,hashtable->arena);
+        cell = hashtable->table[hache];
+        if (hashtable->arena){
+            cell->key = arenaCopyKey(hashtable->arena, key, sizeKey);
+        }
+        else {
+            cell->key = malloc(sizeKey+1);
+            memcpy(cell->key, key, sizeKey);
+            cell->key[sizeKey] = '\0';
+        }
+        cell->hash = hash;
+        hashtable->numberOfPairs +=1;
+        *inserted = 1;
+    }
+    return cell;
+}
+
+/**
+ * @brief Resizes a chaining hash table after an insertion if necessary.
+ */
+static void chainingGrow(HashTable *hashtable){
+    if (hashtable->migrationStep > 0){
+        if ( hashtable->oldTable == NULL && hashtable->sizeTable < hashtable->numberOfPairs ){
+            startMigration(hashtable);
+        }
+        migrateBuckets(hashtable, hashtable->migrationStep);
+        return;
+    }
+    if ( hashtable->sizeTable < hashtable->numberOfPairs ){
+        relinkDoubleSize(hashtable);
+    }
+}
+
+
 /**
  * Insert a new key-value pair into the hash table but the insertion
  * is done without resizing the table. If the key is
@@ -149,15 +718,14 @@ void hashtableInsertWithoutResizing(HashTable *hashtable, string key, int value)
         printf("the hashtable pointer is NULL : error for hashtableInsertWithoutResizing\n");
         return;
     }
-    size_t hache;
-    hache = murmurhash(key,strlen(key),hashtable->sizeTable);
-    if (findKeyInList(hashtable->table[hache],key) == NULL){
-        hashtable->table[hache] = addKeyValueInList(hashtable->table[hache],key,value);
-        hashtable->numberOfPairs +=1;
-
+    if (hashtable->engine == HASHTABLE_OPEN_ADDRESSING){
+        openInsert(hashtable, key, value, 0);
+        return;
     }
-    else{
-        findKeyInList(hashtable->table[hache],key)->value = value; 
+    int inserted;
+    Cell* cell = chainingGetOrInsert(hashtable, key, strlen(key), value, &inserted);
+    if (!inserted){
+        cell->value = value;
     }
     return;
 }
@@ -173,9 +741,28 @@ void hashtableInsertWithoutResizing(HashTable *hashtable, string key, int value)
  * @param hashtable hash table to free
  */
 void hashtableDestroy(HashTable *hashtable) {
-    for(size_t i =0; i<hashtable->sizeTable; i++){
-        freeList(hashtable->table[i]) ;
+    /* with an arena, the cells and the keys are freed with the arena */
+    if (hashtable->engine == HASHTABLE_OPEN_ADDRESSING){
+        for(size_t i =0; hashtable->arena == NULL && i<hashtable->sizeTable; i++){
+            free(hashtable->slots[i].key);
+        }
+        free(hashtable->slots);
+        hashtable->slots = NULL;
+    }
+    else {
+        for(size_t i =0; hashtable->arena == NULL && i<hashtable->sizeTable; i++){
+            freeList(hashtable->table[i]) ;
+        }
+        for(size_t i =hashtable->migrationIndex; hashtable->arena == NULL && i<hashtable->oldSizeTable; i++){
+            freeList(hashtable->oldTable[i]) ;
+        }
+        free(hashtable->oldTable);
+        hashtable->oldTable = NULL;
+        hashtable->oldSizeTable = 0;
+        hashtable->migrationIndex = 0;
     }
+    freeArena(hashtable->arena);
+    hashtable->arena = NULL;
     hashtable->sizeTable = 0;
     hashtable->numberOfPairs = 0;
     free(hashtable->table);
@@ -183,6 +770,21 @@ void hashtableDestroy(HashTable *hashtable) {
     return;
 }
 
+/**
+ * @brief Copies the pairs of a list of cells of a hash table in another chaining hash table
+ *
+ * The keys are supposed not to be in the destination table, and the cached
+ * hashes are reused.
+ */
+static void copyList(HashTable *hashtable, List list){
+    for (Cell* tmp = list; tmp != NULL; tmp = tmp->nextCell){
+        size_t hache = reduceHash(tmp->hash, hashtable->sizeTable, hashtable->powerOfTwo);
+        hashtable->table[hache] = addKeyValueInListArena(hashtable->table[hache],tmp->key,tmp->value,hashtable->arena);
+        hashtable->table[hache]->hash = tmp->hash;
+        hashtable->numberOfPairs += 1;
+    }
+}
+
 /**
  * Returns a new hash table whose table size is the double
  * of the input hashtable and that contains all the pairs
@@ -195,17 +797,39 @@ void hashtableDestroy(HashTable *hashtable) {
  */
 HashTable hashtableDoubleSize(HashTable hashtable) {
     HashTable newHashtable;
+    if (hashtable.engine == HASHTABLE_OPEN_ADDRESSING){
+        newHashtable = hashtableCreateWithEngine(2*hashtable.sizeTable, HASHTABLE_OPEN_ADDRESSING);
+        newHashtable.hashFunction = hashtable.hashFunction;
+        newHashtable.powerOfTwo = hashtable.powerOfTwo;
+        if (hashtable.arena){
+            hashtableUseArena(&newHashtable, hashtable.arena->blockSize);
+        }
+        for (size_t i = 0; i<hashtable.sizeTable;i++){
+            if (hashtable.slots[i].key != NULL){
+                string copy;
+                if (newHashtable.arena){
+                    copy = arenaCopyKey(newHashtable.arena, hashtable.slots[i].key, strlen(hashtable.slots[i].key));
+                }
+                else {
+                    copy = malloc(strlen(hashtable.slots[i].key) + 1);
+                    strcpy(copy, hashtable.slots[i].key);
+                }
+                openPlace(&newHashtable, copy, hashtable.slots[i].value, hashtable.slots[i].hash);
+            }
+        }
+        return newHashtable;
+    }
     newHashtable =  hashtableCreate(2*hashtable.sizeTable);
+    newHashtable.hashFunction = hashtable.hashFunction;
+    newHashtable.powerOfTwo = hashtable.powerOfTwo;
+    if (hashtable.arena){
+        hashtableUseArena(&newHashtable, hashtable.arena->blockSize);
+    }
     for (size_t i = 0; i<hashtable.sizeTable;i++){
-        Cell* tmp;
-        tmp = hashtable.table[i];
-        do{
-            if (tmp != NULL){ 
-                hashtableInsertWithoutResizing(&newHashtable,tmp->key,tmp->value);
-
-                tmp = tmp->nextCell;
-            }
-        }while (tmp!=NULL);
+        copyList(&newHashtable, hashtable.table[i]);
+    }
+    for (size_t i = hashtable.migrationIndex; i<hashtable.oldSizeTable;i++){
+        copyList(&newHashtable, hashtable.oldTable[i]);
     }
     return newHashtable;
 }
@@ -226,29 +850,138 @@ HashTable hashtableDoubleSize(HashTable hashtable) {
  * a pointer on the hash table.
  *
  * Pay attention to the memory !
+ * When the table grows, its cells are relinked in the new table of lists:
+ * the keys are neither copied nor hashed again.
  */
 void hashtableInsert(HashTable *hashtable, string key,  int value){
+    if (hashtable->engine == HASHTABLE_OPEN_ADDRESSING){
+        openInsert(hashtable, key, value, 1);
+        return;
+    }
     hashtableInsertWithoutResizing(hashtable, key, value);
-    
-    if ( hashtable->sizeTable < hashtable->numberOfPairs ){
-        HashTable newHashtable;
-        newHashtable = hashtableDoubleSize(*hashtable);
-        hashtableDestroy(hashtable);
-        *hashtable = newHashtable;
+    chainingGrow(hashtable);
+}
+
+
+/**
+ * Get a pointer on the value associated with the given key. If the key
+ * is not in the hash table, the pair (key, defaultValue) is inserted
+ * (the table is resized if necessary).
+ * The key is hashed once and only one bucket is searched, so that a counter
+ * can be updated in place with (*hashtableGetOrInsert(&table,key,0,NULL))++.
+ *
+ * @param hashtable pointer on the hash table, supposed not to be null.
+ * @param key the key to search for
+ * @param defaultValue the value associated to the key if the key is inserted
+ * @param inserted if not NULL, set to 1 if the key is inserted, 0 otherwise
+ * @return a pointer on the value associated to the key, NULL if the key can't be inserted
+ *
+ * With HASHTABLE_CHAINING, the pointer stays valid until the key is removed.
+ * With HASHTABLE_OPEN_ADDRESSING, it is only valid until the next insertion or removal.
+ */
+int* hashtableGetOrInsert(HashTable *hashtable, string key, int defaultValue, int *inserted){
+    return hashtableGetOrInsertSlice(hashtable, key, strlen(key), defaultValue, inserted);
+}
+
+
+/**
+ * Same as hashtableGetOrInsert, but the key is given by its first
+ * character and its length, and does not need to be null-terminated.
+ * The key is copied only if it is inserted.
+ *
+ * @param hashtable pointer on the hash table, supposed not to be null.
+ * @param key pointer on the first character of the key
+ * @param sizeKey length of the key
+ * @param defaultValue the value associated to the key if the key is inserted
+ * @param inserted if not NULL, set to 1 if the key is inserted, 0 otherwise
+ * @return a pointer on the value associated to the key, NULL if the key can't be inserted
+ */
+int* hashtableGetOrInsertSlice(HashTable *hashtable, const char *key, size_t sizeKey, int defaultValue, int *inserted){
+    int isInserted;
+    int *value = NULL;
+    if (hashtable->engine == HASHTABLE_OPEN_ADDRESSING){
+        long index = openGetOrInsert(hashtable, key, sizeKey, defaultValue, 1, &isInserted);
+        if (index >= 0){
+            value = &hashtable->slots[index].value;
+        }
+    }
+    else{
+        /* the cells are relinked, not moved, when the table grows */
+        Cell* cell = chainingGetOrInsert(hashtable, key, sizeKey, defaultValue, &isInserted);
+        chainingGrow(hashtable);
+        value = &cell->value;
+    }
+    if (inserted){
+        *inserted = isInserted;
     }
+    return value;
 }
+
+/**
+ * Enable the incremental resize of a hash table (HASHTABLE_CHAINING only).
+ *
+ * @param hashtable pointer on the hash table
+ * @param bucketsPerStep number of buckets moved by each operation, 0 disables the incremental resize
+ *
+ * When disabled, a pending migration is completed.
+ */
+void hashtableSetIncrementalResize(HashTable *hashtable, size_t bucketsPerStep){
+    if (hashtable->engine != HASHTABLE_CHAINING){
+        printf("the incremental resize is only available for a chaining hashtable\n");
+        return;
+    }
+    hashtable->migrationStep = bucketsPerStep;
+    if (bucketsPerStep == 0){
+        migrateBuckets(hashtable, hashtable->oldSizeTable);
+    }
+}
+
+/**
+ * Attach counters to a hash table. The counters are updated by every search
+ * of a key, including the ones done by the insertions and the removals.
+ *
+ * @param hashtable pointer on the hash table
+ * @param stats counters to update, NULL to stop counting
+ *
+ * The counters are not reset.
+ */
+void hashtableSetStats(HashTable *hashtable, HashTableStats *stats){
+    hashtable->stats = stats;
+}
+
+/**
+ * Allocate the cells and the keys of an empty hash table in an arena.
+ * Instead of a malloc per cell and per key, they are carved from blocks
+ * of blockSize bytes, and hashtableDestroy frees the blocks at once.
+ * The cells of removed keys are reused, their keys are freed with the arena.
+ *
+ * @param hashtable pointer on the empty hash table
+ * @param blockSize number of bytes of the blocks (0 for the default size)
+ *
+ * The lists of a hash table using an arena must not be freed by freeList.
+ */
+void hashtableUseArena(HashTable *hashtable, size_t blockSize){
+    if (hashtable->numberOfPairs > 0){
+        printf("the hashtable is not empty : error for hashtableUseArena\n");
+        return;
+    }
+    if (hashtable->arena == NULL){
+        hashtable->arena = newArena(blockSize);
+    }
+}
+
 /**
  * Test if a key is in the hash table.
  * @param hashtable the hash table to search in
  * @param key the key to search for
  * @return 1 if the key is in the table, 0 otherwise.
  */
- 
- // appeler mumrush avec la clé puis juste appeler findKeyInList(hashtable.table[haché], clé)
+
 int hashtableHasKey(HashTable hashtable, string key){
-    size_t hache ;
-    hache = murmurhash(key, strlen(key), hashtable.sizeTable) ;
-    if (findKeyInList(hashtable.table[hache],key) != NULL) {
+    if (hashtable.engine == HASHTABLE_OPEN_ADDRESSING){
+        return openFindSlot(hashtable, key, strlen(key), hashKey(&hashtable, key, strlen(key))) >= 0;
+    }
+    if (findKeyInTable(hashtable,key) != NULL) {
         return 1;
     }
    
@@ -264,10 +997,16 @@ int hashtableHasKey(HashTable hashtable, string key){
  * @return the value associated to the key
  */
 int hashtableGetValue(HashTable hashtable, string key){
-    size_t hache ;
-    hache = murmurhash(key, strlen(key), hashtable.sizeTable) ;
+    if (hashtable.engine == HASHTABLE_OPEN_ADDRESSING){
+        long index = openFindSlot(hashtable, key, strlen(key), hashKey(&hashtable, key, strlen(key)));
+        if (index >= 0){
+            return hashtable.slots[index].value;
+        }
+        printf("hashTableGetValue : error, the key is not in the hashtable to search in\n");
+        return EXIT_FAILURE ;
+    }
     Cell* tmp;
-    tmp = findKeyInList(hashtable.table[hache],key) ;
+    tmp = findKeyInTable(hashtable,key) ;
     if (tmp){
         return tmp->value ;
     }
@@ -286,12 +1025,35 @@ int hashtableGetValue(HashTable hashtable, string key){
  * @return 0 if the key was not in the hash table, 1 otherwise
  */
 int hashtableRemove(HashTable *hashtable, string key){
-    size_t hache ;
-    hache = murmurhash(key, strlen(key), hashtable->sizeTable) ;
-    Cell* tmp;
-    tmp = findKeyInList(hashtable->table[hache],key) ;
-    if (tmp){
-        hashtable->table[hache] = delKeyInList(hashtable->table[hache],key) ;
+    if (hashtable->engine == HASHTABLE_OPEN_ADDRESSING){
+        if (openRemove(hashtable, key)){
+            return 1;
+        }
+        printf("the key is not in the hashtable to remove from\n");
+        return 0;
+    }
+    size_t sizeKey = strlen(key);
+    uint32_t hash = hashKey(hashtable, key, sizeKey);
+    Cell** link = findLinkInBucket(&hashtable->table[reduceHash(hash, hashtable->sizeTable, hashtable->powerOfTwo)], key, sizeKey, hash, hashtable->stats);
+    if (link == NULL){
+        link = findLinkInOldTable(*hashtable, key, sizeKey, hash);
+    }
+    int removed = 0;
+    if (link){
+        Cell* tmp = *link;
+        *link = tmp->nextCell;
+        if (hashtable->arena){
+            arenaReleaseCell(hashtable->arena, tmp);
+        }
+        else {
+            free(tmp->key);
+            free(tmp);
+        }
+        removed = 1;
+    }
+    migrateBuckets(hashtable, hashtable->migrationStep);
+    if (removed){
+        hashtable->numberOfPairs -= 1;
         return 1 ;
     }
     else{
@@ -301,6 +1063,183 @@ int hashtableRemove(HashTable *hashtable, string key){
 }
 
 
+/**
+ * @brief Returns 1 if the character separates two words (same convention as "%s" in scanf)
+ */
+static int isWordSeparator(char c){
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Maps a file in memory, returns NULL if the file can't be mapped or is empty
+ */
+static char* mapFile(char *filename, size_t *size){
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0){
+        printf("Error opening file %s\n",filename);
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size == 0){
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t) info.st_size;
+    char *text = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (text == MAP_FAILED){
+        printf("Error mapping file %s\n",filename);
+        return NULL;
+    }
+    madvise(text, *size, MADV_SEQUENTIAL);
+    return text;
+}
+
+/**
+ * @brief Counts the occurrences of the words of text[begin..end[ in a hash table,
+ * returns the number of words
+ */
+static size_t countWordsInText(HashTable *hashtable, const char *text, size_t begin, size_t end){
+    size_t totalCount = 0;
+    size_t i = begin;
+    while (i < end){
+        while (i < end && isWordSeparator(text[i])){
+            i++;
+        }
+        size_t start = i;
+        while (i < end && !isWordSeparator(text[i])){
+            i++;
+        }
+        if (i > start){
+            (*hashtableGetOrInsertSlice(hashtable, text + start, i - start, 0, NULL))++;
+            totalCount++;
+        }
+    }
+    return totalCount;
+}
+
+/**
+ * Counts the occurrences of the words of a text file in a hash table.
+ * The words are separated by white spaces. The file is memory-mapped
+ * and the words are hashed and compared in place: a word is copied
+ * only the first time it is inserted in the table.
+ *
+ * @param hashtable pointer on the hash table, the value of each word is incremented
+ * @param filename name of the file
+ * @return the number of words in the file (0 if the file can't be read)
+ */
+size_t hashtableCountWordsInFile(HashTable *hashtable, char *filename){
+    size_t size;
+    char *text = mapFile(filename, &size);
+    if (text == NULL){
+        return 0;
+    }
+    size_t totalCount = countWordsInText(hashtable, text, 0, size);
+    munmap(text, size);
+    return totalCount;
+}
+
+
+/**
+ * @brief Adds the values of all the pairs of src to the values of the same keys in dest
+ */
+static void addValuesOfTable(HashTable *dest, HashTable src){
+    if (src.engine == HASHTABLE_OPEN_ADDRESSING){
+        for (size_t i = 0; i < src.sizeTable; i++){
+            if (src.slots[i].key != NULL){
+                *hashtableGetOrInsert(dest, src.slots[i].key, 0, NULL) += src.slots[i].value;
+            }
+        }
+        return;
+    }
+    for (size_t i = 0; i < src.sizeTable; i++){
+        for (Cell* tmp = src.table[i]; tmp != NULL; tmp = tmp->nextCell){
+            *hashtableGetOrInsert(dest, tmp->key, 0, NULL) += tmp->value;
+        }
+    }
+    for (size_t i = src.migrationIndex; i < src.oldSizeTable; i++){
+        for (Cell* tmp = src.oldTable[i]; tmp != NULL; tmp = tmp->nextCell){
+            *hashtableGetOrInsert(dest, tmp->key, 0, NULL) += tmp->value;
+        }
+    }
+}
+
+/**
+ * @brief Work of a thread of hashtableCountWordsInFileParallel: a chunk of text and its own table
+ */
+typedef struct countTask{
+    const char *text;
+    size_t begin;
+    size_t end;
+    HashTable table;
+    size_t totalCount;
+} CountTask;
+
+/**
+ * @brief Thread function of hashtableCountWordsInFileParallel
+ */
+static void* countWordsTask(void *argument){
+    CountTask *task = argument;
+    task->totalCount = countWordsInText(&task->table, task->text, task->begin, task->end);
+    return NULL;
+}
+
+/**
+ * Same as hashtableCountWordsInFile, but the file is split in nbThreads
+ * chunks (at white spaces) counted in parallel, each thread in its own hash
+ * table. The tables of the threads are then merged in the input hash table,
+ * so the result is the same as the one of hashtableCountWordsInFile.
+ *
+ * @param hashtable pointer on the hash table, the value of each word is incremented
+ * @param filename name of the file
+ * @param nbThreads number of threads
+ * @return the number of words in the file (0 if the file can't be read)
+ */
+size_t hashtableCountWordsInFileParallel(HashTable *hashtable, char *filename, int nbThreads){
+    if (nbThreads <= 1){
+        return hashtableCountWordsInFile(hashtable, filename);
+    }
+    size_t size;
+    char *text = mapFile(filename, &size);
+    if (text == NULL){
+        return 0;
+    }
+    CountTask *tasks = malloc(sizeof(CountTask)*nbThreads);
+    pthread_t *threads = malloc(sizeof(pthread_t)*nbThreads);
+    size_t begin = 0;
+    for (int t = 0; t < nbThreads; t++){
+        /* the end of a chunk is moved to the next separator so that no word is cut */
+        size_t end = (t == nbThreads - 1) ? size : (size / nbThreads) * (t + 1);
+        if (end < begin){
+            end = begin;
+        }
+        while (end < size && !isWordSeparator(text[end])){
+            end++;
+        }
+        tasks[t].text = text;
+        tasks[t].begin = begin;
+        tasks[t].end = end;
+        tasks[t].table = hashtableCreateWithEngine(500, hashtable->engine);
+        /* the words of a chunk are copied by the merge, the table of a thread is freed at once */
+        hashtableUseArena(&tasks[t].table, 0);
+        tasks[t].totalCount = 0;
+        pthread_create(&threads[t], NULL, countWordsTask, &tasks[t]);
+        begin = end;
+    }
+    size_t totalCount = 0;
+    for (int t = 0; t < nbThreads; t++){
+        pthread_join(threads[t], NULL);
+        addValuesOfTable(hashtable, tasks[t].table);
+        hashtableDestroy(&tasks[t].table);
+        totalCount += tasks[t].totalCount;
+    }
+    free(threads);
+    free(tasks);
+    munmap(text, size);
+    return totalCount;
+}
+
+
 /**
  * Prints the number of words and distinct words in the file
  * "potter-clean.txt"
@@ -309,31 +1248,16 @@ int hashtableRemove(HashTable *hashtable, string key){
 void countDistinctWordsInBook(){
     HashTable table;
     table = hashtableCreate(500);
-    char str[100]; 
-    FILE* fp;
-    fp = fopen("potter-clean.txt", "r");
-    int totalCount;
-    totalCount = 0;
-    int unique;
-    unique = 0;
-    while (fscanf(fp,"%s", str) != -1){
-        totalCount++;
-        int inTable ;
-        inTable = hashtableHasKey(table,str);
-        if (inTable == 0){
-            unique++;
-        }
-        hashtableInsert(&table, str,
-                       inTable == 0 ? 1 :  hashtableGetValue(table,str) + 1) ;
-
-    }
+    size_t totalCount;
+    totalCount = hashtableCountWordsInFile(&table, "potter-clean.txt");
     for (size_t i = 0; i < table.sizeTable; i++) {
         if (table.table[i] != NULL){
             printList(table.table[i],1);
             printf("\n");
         }
     }
-    printf("Nombre total de mots : %d et Nombre total de mots uniques :  %d\n",totalCount,unique);
+    printf("Nombre total de mots : %zu et Nombre total de mots uniques :  %zu\n",totalCount,table.numberOfPairs);
+    hashtableDestroy(&table);
     return;
 
 }
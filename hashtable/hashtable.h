@@ -13,19 +13,88 @@
 #ifndef HASHTABLE_H_INCLUDED
 #define HASHTABLE_H_INCLUDED
 
+#include <stdint.h>
 #include "../list/list.h"
 
+/**
+ * @brief Storage engine of a hash table, chosen at creation time
+ */
+typedef enum hashtableEngine{
+    HASHTABLE_CHAINING = 0, /**< table of linked lists (default engine) */
+    HASHTABLE_OPEN_ADDRESSING /**< Robin Hood open addressing over a flat array of slots */
+} HashTableEngine;
+
+/**
+ * @brief Hash function of the keys of a hash table
+ *
+ * Returns the 32-bit hash code of the key of length sizeKey. The key
+ * is not necessarily null-terminated.
+ */
+typedef uint32_t (*HashFunction)(string key, size_t sizeKey);
+
+/**
+ * @brief Definition of a slot of an open addressing hash table
+ *
+ * An empty slot has a NULL key. [probe] is the distance between the slot
+ * and the home slot of the key, it is used by the Robin Hood insertion.
+ */
+typedef struct slot{
+    string key; /**< Key of the pair, NULL if the slot is empty */
+    int value; /**< Value of the pair */
+    uint32_t hash; /**< Full 32-bit hash of the key */
+    uint32_t probe; /**< Distance from the home slot of the key */
+} Slot;
+
+/**
+ * @brief Counters of the work done by the searches of keys in a hash table
+ *
+ * Each search compares the cached hash of the visited cells (or slots) with the
+ * hash of the key and calls strcmp only when both hashes are equal.
+ */
+typedef struct hashtableStats{
+    size_t lookups; /**< Number of searches of a key */
+    size_t cellsVisited; /**< Number of cells or slots visited, i.e. of hash comparisons */
+    size_t keyComparisons; /**< Number of string comparisons */
+} HashTableStats;
+
 /**
  * @brief Definition of a hash table data structure
  *
  * The structure contains the size of the table of list [sizeTable], the number of pairs
  * (key,value)  stored in the hash table [numberOfPairs], dans
  * the table of List of pairs [table].
+ * With the engine HASHTABLE_OPEN_ADDRESSING, the pairs are stored in the
+ * array [slots] of sizeTable slots (a power of two) and [table] is NULL.
+ *
+ * When the incremental resize is enabled ([migrationStep] > 0), a growing
+ * table keeps its previous table of lists [oldTable] of size [oldSizeTable]
+ * until all its buckets are moved to [table]. The buckets of [oldTable] with
+ * an index lower than [migrationIndex] are already moved.
+ *
+ * If [stats] is not NULL, the searches of keys update the pointed counters.
+ *
+ * If [arena] is not NULL, the cells and the keys of the table are allocated
+ * in this arena and freed all at once by hashtableDestroy. Otherwise each cell
+ * and each key is allocated by malloc.
+ *
+ * The keys are hashed by [hashFunction] (murmurhash32 by default). If
+ * [powerOfTwo] is not 0, sizeTable is a power of two and the list of a key
+ * is given by a mask on its hash instead of a modulo.
  */
 typedef struct hashtable{
     size_t sizeTable;
     size_t numberOfPairs;
     List *table;
+    HashTableEngine engine;
+    Slot *slots;
+    List *oldTable;
+    size_t oldSizeTable;
+    size_t migrationIndex;
+    size_t migrationStep;
+    HashTableStats *stats;
+    Arena *arena;
+    HashFunction hashFunction;
+    int powerOfTwo;
 } HashTable;
 
 /**
@@ -38,6 +107,33 @@ typedef struct hashtable{
  */
 size_t murmurhash(string key, size_t sizeKey, size_t maxValue);
 
+/**
+ * @brief Hash function murmurhash without the final reduction
+ *
+ * @param key string representing the key to hash
+ * @param sizeKey length of the string key
+ * @return the full 32-bit hash code of the key
+ */
+uint32_t murmurhash32(string key, size_t sizeKey);
+
+/**
+ * @brief Hash function in the style of wyhash, reading 16 bytes per step
+ *
+ * @param key string representing the key to hash
+ * @param sizeKey length of the string key
+ * @return the 64-bit hash code of the key
+ */
+uint64_t widehash64(string key, size_t sizeKey);
+
+/**
+ * @brief Hash function widehash64 folded in 32 bits, usable as a HashFunction
+ *
+ * @param key string representing the key to hash
+ * @param sizeKey length of the string key
+ * @return the 32-bit hash code of the key
+ */
+uint32_t widehash32(string key, size_t sizeKey);
+
 
 /**
  * Create a new hash table with the given size.
@@ -47,6 +143,28 @@ size_t murmurhash(string key, size_t sizeKey, size_t maxValue);
  */
 HashTable hashtableCreate(size_t sizeTable);
 
+/**
+ * Create a new hash table with the given size and storage engine.
+ * With HASHTABLE_OPEN_ADDRESSING, the size is rounded up to a power of two.
+ *
+ * @param sizeTable the size of the table
+ * @param engine the storage engine of the table
+ * @return an empty hash table with the convenient table size
+ */
+HashTable hashtableCreateWithEngine(size_t sizeTable, HashTableEngine engine);
+
+/**
+ * Create a new hash table with the given size, storage engine and hash function.
+ * The size is rounded up to a power of two, and the list (or the first slot)
+ * of a key is given by the lowest bits of its hash instead of a modulo.
+ *
+ * @param sizeTable the size of the table
+ * @param engine the storage engine of the table
+ * @param hashFunction the hash function of the keys, NULL for murmurhash32
+ * @return an empty hash table with the convenient table size
+ */
+HashTable hashtableCreateWithHash(size_t sizeTable, HashTableEngine engine, HashFunction hashFunction);
+
 /**
  * Free the memory used by the input hash table (given with a pointer).
  * The fields sizeTable and numberOfPairs are set to 0.
@@ -105,9 +223,81 @@ HashTable hashtableDoubleSize(HashTable hashtable);
  * a pointer on the hash table.
  *
  * Pay attention to the memory !
+ * When the table grows, its cells are relinked in the new table of lists:
+ * the keys are neither copied nor hashed again.
  */
 void hashtableInsert(HashTable *hashtable, string key,  int value);
 
+/**
+ * Enable the incremental resize of a hash table (HASHTABLE_CHAINING only).
+ * When the table has to grow, hashtableInsert allocates the new table of lists
+ * but only moves [bucketsPerStep] buckets of the previous table. The other buckets
+ * are moved by the next calls to hashtableInsert and hashtableRemove, so that
+ * no insertion has to rehash the whole table.
+ *
+ * @param hashtable pointer on the hash table
+ * @param bucketsPerStep number of buckets moved by each operation, 0 disables the incremental resize
+ *
+ * When disabled, a pending migration is completed.
+ */
+void hashtableSetIncrementalResize(HashTable *hashtable, size_t bucketsPerStep);
+
+/**
+ * Attach counters to a hash table. The counters are updated by every search
+ * of a key, including the ones done by the insertions and the removals.
+ *
+ * @param hashtable pointer on the hash table
+ * @param stats counters to update, NULL to stop counting
+ *
+ * The counters are not reset.
+ */
+void hashtableSetStats(HashTable *hashtable, HashTableStats *stats);
+
+/**
+ * Allocate the cells and the keys of an empty hash table in an arena.
+ * Instead of a malloc per cell and per key, they are carved from blocks
+ * of blockSize bytes, and hashtableDestroy frees the blocks at once.
+ * The cells of removed keys are reused, their keys are freed with the arena.
+ *
+ * @param hashtable pointer on the empty hash table
+ * @param blockSize number of bytes of the blocks (0 for the default size)
+ *
+ * The lists of a hash table using an arena must not be freed by freeList.
+ */
+void hashtableUseArena(HashTable *hashtable, size_t blockSize);
+
+/**
+ * Get a pointer on the value associated with the given key. If the key
+ * is not in the hash table, the pair (key, defaultValue) is inserted
+ * (the table is resized if necessary).
+ * The key is hashed once and only one bucket is searched, so that a counter
+ * can be updated in place with (*hashtableGetOrInsert(&table,key,0,NULL))++.
+ *
+ * @param hashtable pointer on the hash table, supposed not to be null.
+ * @param key the key to search for
+ * @param defaultValue the value associated to the key if the key is inserted
+ * @param inserted if not NULL, set to 1 if the key is inserted, 0 otherwise
+ * @return a pointer on the value associated to the key, NULL if the key can't be inserted
+ *
+ * With HASHTABLE_CHAINING, the pointer stays valid until the key is removed.
+ * With HASHTABLE_OPEN_ADDRESSING, it is only valid until the next insertion or removal.
+ */
+int* hashtableGetOrInsert(HashTable *hashtable, string key, int defaultValue, int *inserted);
+
+/**
+ * Same as hashtableGetOrInsert, but the key is given by its first
+ * character and its length, and does not need to be null-terminated.
+ * The key is copied only if it is inserted.
+ *
+ * @param hashtable pointer on the hash table, supposed not to be null.
+ * @param key pointer on the first character of the key
+ * @param sizeKey length of the key
+ * @param defaultValue the value associated to the key if the key is inserted
+ * @param inserted if not NULL, set to 1 if the key is inserted, 0 otherwise
+ * @return a pointer on the value associated to the key, NULL if the key can't be inserted
+ */
+int* hashtableGetOrInsertSlice(HashTable *hashtable, const char *key, size_t sizeKey, int defaultValue, int *inserted);
+
 /**
  * Test if a key is in the hash table.
  * @param hashtable the hash table to search in, supposed to be non null
@@ -144,6 +334,31 @@ int hashtableRemove(HashTable *hashtable, string key);
  */
 void hashtablePrint(HashTable hashtable) ;
 
+/**
+ * Counts the occurrences of the words of a text file in a hash table.
+ * The words are separated by white spaces. The file is memory-mapped
+ * and the words are hashed and compared in place: a word is copied
+ * only the first time it is inserted in the table.
+ *
+ * @param hashtable pointer on the hash table, the value of each word is incremented
+ * @param filename name of the file
+ * @return the number of words in the file (0 if the file can't be read)
+ */
+size_t hashtableCountWordsInFile(HashTable *hashtable, char *filename);
+
+/**
+ * Same as hashtableCountWordsInFile, but the file is split in nbThreads
+ * chunks (at white spaces) counted in parallel, each thread in its own hash
+ * table. The tables of the threads are then merged in the input hash table,
+ * so the result is the same as the one of hashtableCountWordsInFile.
+ *
+ * @param hashtable pointer on the hash table, the value of each word is incremented
+ * @param filename name of the file
+ * @param nbThreads number of threads
+ * @return the number of words in the file (0 if the file can't be read)
+ */
+size_t hashtableCountWordsInFileParallel(HashTable *hashtable, char *filename, int nbThreads);
+
 /**
  * Prints the number of words and distinct words in the file
  * "potter-clean.txt"
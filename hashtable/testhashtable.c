@@ -12,7 +12,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "hashtable.h"
+#include "concurrenthashtable.h"
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 void testMurmurhash(){
     printf("---- Test murmurhash ----\n");
@@ -204,6 +207,616 @@ void testCountDistinctWordsInBook(){
 
 }
 
+/**
+ * Loads the words of "potter-clean.txt" in memory. Returns the number of words,
+ * the array of words is stored in *words and must be freed by the caller.
+ */
+size_t loadBookWords(string **words){
+    FILE* fp = fopen("potter-clean.txt", "r");
+    if (fp == NULL){
+        printf("Error opening file potter-clean.txt\n");
+        *words = NULL;
+        return 0;
+    }
+    size_t capacity = 1024;
+    size_t n = 0;
+    *words = malloc(sizeof(string)*capacity);
+    char str[100];
+    while (fscanf(fp,"%99s", str) != -1){
+        if (n == capacity){
+            capacity *= 2;
+            *words = realloc(*words, sizeof(string)*capacity);
+        }
+        (*words)[n] = malloc(strlen(str)+1);
+        strcpy((*words)[n], str);
+        n++;
+    }
+    fclose(fp);
+    return n;
+}
+
+/**
+ * Counts the words of the book with the given engine, as countDistinctWordsInBook,
+ * and returns the elapsed time in seconds.
+ */
+double benchmarkCountWords(string *words, size_t nbWords, HashTableEngine engine, int nbRuns, size_t *distinct){
+    clock_t start = clock();
+    for (int run = 0; run < nbRuns; run++){
+        HashTable table = hashtableCreateWithEngine(500, engine);
+        for (size_t i = 0; i < nbWords; i++){
+            int inTable = hashtableHasKey(table, words[i]);
+            hashtableInsert(&table, words[i],
+                            inTable == 0 ? 1 : hashtableGetValue(table, words[i]) + 1);
+        }
+        *distinct = table.numberOfPairs;
+        hashtableDestroy(&table);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Counts the words of the book with the given engine and hashtableGetOrInsert,
+ * and returns the elapsed time in seconds.
+ */
+double benchmarkCountWordsGetOrInsert(string *words, size_t nbWords, HashTableEngine engine, int nbRuns, size_t *distinct){
+    clock_t start = clock();
+    for (int run = 0; run < nbRuns; run++){
+        HashTable table = hashtableCreateWithEngine(500, engine);
+        for (size_t i = 0; i < nbWords; i++){
+            (*hashtableGetOrInsert(&table, words[i], 0, NULL))++;
+        }
+        *distinct = table.numberOfPairs;
+        hashtableDestroy(&table);
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void testCompareEngines(){
+    printf("---- Test compare engines on potter-clean.txt ----\n");
+    string *words;
+    size_t nbWords = loadBookWords(&words);
+    int nbRuns = 20;
+    size_t distinctChaining, distinctOpen;
+    double tChaining = benchmarkCountWords(words, nbWords, HASHTABLE_CHAINING, nbRuns, &distinctChaining);
+    double tOpen = benchmarkCountWords(words, nbWords, HASHTABLE_OPEN_ADDRESSING, nbRuns, &distinctOpen);
+    printf("%zu words, %d runs\n", nbWords, nbRuns);
+    printf("chaining        : %zu distinct words, %.3lf s, %.1lf ns/word\n",
+           distinctChaining, tChaining, 1e9*tChaining/(nbWords*nbRuns));
+    printf("open addressing : %zu distinct words, %.3lf s, %.1lf ns/word\n",
+           distinctOpen, tOpen, 1e9*tOpen/(nbWords*nbRuns));
+    double tChainingGetOrInsert = benchmarkCountWordsGetOrInsert(words, nbWords, HASHTABLE_CHAINING, nbRuns, &distinctChaining);
+    double tOpenGetOrInsert = benchmarkCountWordsGetOrInsert(words, nbWords, HASHTABLE_OPEN_ADDRESSING, nbRuns, &distinctOpen);
+    printf("chaining with hashtableGetOrInsert        : %zu distinct words, %.3lf s, %.1lf ns/word (speedup %.2lf)\n",
+           distinctChaining, tChainingGetOrInsert, 1e9*tChainingGetOrInsert/(nbWords*nbRuns), tChaining/tChainingGetOrInsert);
+    printf("open addressing with hashtableGetOrInsert : %zu distinct words, %.3lf s, %.1lf ns/word (speedup %.2lf)\n",
+           distinctOpen, tOpenGetOrInsert, 1e9*tOpenGetOrInsert/(nbWords*nbRuns), tOpen/tOpenGetOrInsert);
+    for (size_t i = 0; i < nbWords; i++)
+        free(words[i]);
+    free(words);
+    printf("---- Fin test compare engines ----\n");
+}
+
+/**
+ * Returns the time elapsed since t in nanoseconds.
+ */
+double elapsedNanoseconds(struct timespec t){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - t.tv_sec)*1e9 + (now.tv_nsec - t.tv_nsec);
+}
+
+/**
+ * Comparison function of doubles for qsort.
+ */
+int doubleComparator(const void *first, const void *second){
+    double a = *(const double*) first;
+    double b = *(const double*) second;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Inserts nbKeys distinct keys and prints the mean latency of hashtableInsert,
+ * its 99th and 99.99th percentiles and the worst one.
+ */
+void benchmarkInsertLatency(size_t nbKeys, size_t bucketsPerStep){
+    HashTable table = hashtableCreate(1);
+    hashtableSetIncrementalResize(&table, bucketsPerStep);
+    char key[32];
+    double *latencies = malloc(sizeof(double)*nbKeys);
+    double total = 0;
+    for (size_t i = 0; i < nbKeys; i++){
+        sprintf(key, "key %zu", i);
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        hashtableInsert(&table, key, (int) i);
+        latencies[i] = elapsedNanoseconds(start);
+        total += latencies[i];
+    }
+    qsort(latencies, nbKeys, sizeof(double), doubleComparator);
+    printf("buckets per step %4zu : mean %.0lf ns, p99 %.0lf ns, p99.99 %.0lf ns, worst %.3lf ms\n",
+           bucketsPerStep, total/nbKeys, latencies[nbKeys*99/100],
+           latencies[nbKeys*9999/10000], latencies[nbKeys-1]/1e6);
+    free(latencies);
+    hashtableDestroy(&table);
+}
+
+void testIncrementalResize(){
+    printf("---- Test incremental resize (1000000 insertions) ----\n");
+    benchmarkInsertLatency(1000000, 0);
+    benchmarkInsertLatency(1000000, 1);
+    benchmarkInsertLatency(1000000, 8);
+    printf("---- Fin test incremental resize ----\n");
+}
+
+/**
+ * Counts the words of the book and prints the number of visited cells and of
+ * string comparisons per search. With resize==0, the table keeps its initial size.
+ */
+void benchmarkLookupStats(string *words, size_t nbWords, HashTableEngine engine, size_t size, int resize){
+    HashTableStats stats = {0, 0, 0};
+    HashTable table = hashtableCreateWithEngine(size, engine);
+    hashtableSetStats(&table, &stats);
+    for (size_t i = 0; i < nbWords; i++){
+        int inTable = hashtableHasKey(table, words[i]);
+        int value = inTable == 0 ? 1 : hashtableGetValue(table, words[i]) + 1;
+        if (resize)
+            hashtableInsert(&table, words[i], value);
+        else
+            hashtableInsertWithoutResizing(&table, words[i], value);
+    }
+    printf("%-15s size %5zu load %6.2lf : %.3lf cells visited and %.3lf string comparisons per search\n",
+           engine == HASHTABLE_CHAINING ? "chaining" : "open addressing",
+           table.sizeTable, (double) table.numberOfPairs / table.sizeTable,
+           (double) stats.cellsVisited / stats.lookups, (double) stats.keyComparisons / stats.lookups);
+    hashtableDestroy(&table);
+}
+
+void testLookupStats(){
+    printf("---- Test comparisons per search on potter-clean.txt ----\n");
+    string *words;
+    size_t nbWords = loadBookWords(&words);
+    benchmarkLookupStats(words, nbWords, HASHTABLE_CHAINING, 500, 1);
+    benchmarkLookupStats(words, nbWords, HASHTABLE_CHAINING, 64, 0);
+    benchmarkLookupStats(words, nbWords, HASHTABLE_OPEN_ADDRESSING, 500, 1);
+    for (size_t i = 0; i < nbWords; i++)
+        free(words[i]);
+    free(words);
+    printf("---- Fin test comparisons per search ----\n");
+}
+
+/**
+ * Writes the file "potter-clean.txt" nbCopies times in the file filename
+ * and returns the size of the file in bytes.
+ */
+size_t replicateBook(char *filename, int nbCopies){
+    FILE* in = fopen("potter-clean.txt", "r");
+    FILE* out = fopen(filename, "w");
+    if (in == NULL || out == NULL){
+        printf("Error opening files for the replication of the book\n");
+        exit(-1);
+    }
+    fseek(in, 0, SEEK_END);
+    size_t size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    char *buffer = malloc(size);
+    if (fread(buffer, 1, size, in) != size){
+        printf("Error reading potter-clean.txt\n");
+        exit(-1);
+    }
+    for (int i = 0; i < nbCopies; i++)
+        fwrite(buffer, 1, size, out);
+    free(buffer);
+    fclose(in);
+    fclose(out);
+    return size*nbCopies;
+}
+
+void testCountWordsThroughput(){
+    printf("---- Test throughput of the word count ----\n");
+    char *filename = "potter-replicated.txt";
+    size_t size = replicateBook(filename, 50);
+    double megabytes = size/1e6;
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    HashTable table = hashtableCreate(500);
+    FILE* fp = fopen(filename, "r");
+    char str[100];
+    size_t totalScanf = 0;
+    while (fscanf(fp,"%99s", str) != -1){
+        (*hashtableGetOrInsert(&table, str, 0, NULL))++;
+        totalScanf++;
+    }
+    fclose(fp);
+    double tScanf = elapsedNanoseconds(start)/1e9;
+    size_t distinctScanf = table.numberOfPairs;
+    hashtableDestroy(&table);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    table = hashtableCreate(500);
+    size_t totalMmap = hashtableCountWordsInFile(&table, filename);
+    double tMmap = elapsedNanoseconds(start)/1e9;
+    size_t distinctMmap = table.numberOfPairs;
+    hashtableDestroy(&table);
+
+    printf("%.1lf MB\n", megabytes);
+    printf("fscanf      : %zu words, %zu distinct, %.3lf s, %.1lf MB/s\n",
+           totalScanf, distinctScanf, tScanf, megabytes/tScanf);
+    printf("mmap slices : %zu words, %zu distinct, %.3lf s, %.1lf MB/s\n",
+           totalMmap, distinctMmap, tMmap, megabytes/tMmap);
+    remove(filename);
+    printf("---- Fin test throughput of the word count ----\n");
+}
+
+/**
+ * Returns 1 if both chaining hash tables contain the same pairs, 0 otherwise.
+ */
+int sameCounts(HashTable first, HashTable second){
+    if (first.numberOfPairs != second.numberOfPairs)
+        return 0;
+    for (size_t i = 0; i < first.sizeTable; i++){
+        for (Cell* tmp = first.table[i]; tmp != NULL; tmp = tmp->nextCell){
+            if (!hashtableHasKey(second, tmp->key) || hashtableGetValue(second, tmp->key) != tmp->value)
+                return 0;
+        }
+    }
+    return 1;
+}
+
+void testCountWordsParallel(){
+    printf("---- Test parallel word count ----\n");
+    char *filename = "potter-replicated.txt";
+    size_t size = replicateBook(filename, 50);
+    double megabytes = size/1e6;
+
+    HashTable reference = hashtableCreate(500);
+    size_t totalReference = hashtableCountWordsInFile(&reference, filename);
+
+    printf("%.1lf MB\n", megabytes);
+    double tOneThread = 0;
+    for (int nbThreads = 1; nbThreads <= 8; nbThreads *= 2){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        HashTable table = hashtableCreate(500);
+        size_t total = hashtableCountWordsInFileParallel(&table, filename, nbThreads);
+        double t = elapsedNanoseconds(start)/1e9;
+        if (nbThreads == 1)
+            tOneThread = t;
+        printf("%d threads : %zu words, %zu distinct, %.3lf s, %.1lf MB/s, speedup %.2lf, %s\n",
+               nbThreads, total, table.numberOfPairs, t, megabytes/t, tOneThread/t,
+               total == totalReference && sameCounts(reference, table) ? "same counts" : "DIFFERENT COUNTS");
+        hashtableDestroy(&table);
+    }
+    hashtableDestroy(&reference);
+    remove(filename);
+    printf("---- Fin test parallel word count ----\n");
+}
+
+/**
+ * @brief Work of a thread of the concurrent tests
+ */
+typedef struct concurrentTask{
+    ConcurrentHashTable *hashtable; /**< Shared hash table */
+    string *keys; /**< Keys used by the thread */
+    size_t nbKeys; /**< Number of keys */
+    int readPercent; /**< Percentage of reads among the operations */
+    size_t nbOperations; /**< Number of operations of the benchmark */
+    uint32_t seed; /**< Seed of the generator of the thread */
+    size_t errors; /**< Number of wrong results */
+} ConcurrentTask;
+
+/**
+ * @brief Generator xorshift32 local to a thread
+ */
+uint32_t xorshift32(uint32_t *state){
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Stress: each thread inserts, increments, reads and removes its own keys
+ * while the other threads do the same on the same table
+ */
+void* concurrentStressTask(void *argument){
+    ConcurrentTask *task = argument;
+    for (int round = 0; round < 3; round++){
+        for (size_t i = 0; i < task->nbKeys; i++){
+            concurrentHashtableInsert(task->hashtable, task->keys[i], (int) i);
+        }
+        for (size_t i = 0; i < task->nbKeys; i++){
+            if (concurrentHashtableAdd(task->hashtable, task->keys[i], 1) != (int) i + 1)
+                task->errors++;
+        }
+        for (size_t i = 0; i < task->nbKeys; i++){
+            int value;
+            if (!concurrentHashtableGetValue(task->hashtable, task->keys[i], &value) || value != (int) i + 1)
+                task->errors++;
+        }
+        /* the odd keys are removed, except at the last round */
+        for (size_t i = 1; round < 2 && i < task->nbKeys; i += 2){
+            if (!concurrentHashtableRemove(task->hashtable, task->keys[i]))
+                task->errors++;
+            if (concurrentHashtableHasKey(task->hashtable, task->keys[i]))
+                task->errors++;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns nbKeys distinct keys prefixed by the number of the thread
+ */
+string* createKeys(int thread, size_t nbKeys){
+    string *keys = malloc(sizeof(string)*nbKeys);
+    for (size_t i = 0; i < nbKeys; i++){
+        keys[i] = malloc(32);
+        sprintf(keys[i], "t%d-key%zu", thread, i);
+    }
+    return keys;
+}
+
+void freeKeys(string *keys, size_t nbKeys){
+    for (size_t i = 0; i < nbKeys; i++){
+        free(keys[i]);
+    }
+    free(keys);
+}
+
+void testConcurrentStress(){
+    printf("---- Test concurrent hash table stress ----\n");
+    int nbThreads = 8;
+    size_t nbKeys = 20000;
+    ConcurrentHashTable *hashtable = concurrentHashtableCreate(16, 1);
+    pthread_t threads[8];
+    ConcurrentTask tasks[8];
+    for (int t = 0; t < nbThreads; t++){
+        tasks[t] = (ConcurrentTask) {hashtable, createKeys(t, nbKeys), nbKeys, 0, 0, 0, 0};
+        pthread_create(&threads[t], NULL, concurrentStressTask, &tasks[t]);
+    }
+    size_t errors = 0;
+    for (int t = 0; t < nbThreads; t++){
+        pthread_join(threads[t], NULL);
+        errors += tasks[t].errors;
+    }
+    concurrentHashtableReclaim(hashtable);
+    for (int t = 0; t < nbThreads; t++){
+        for (size_t i = 0; i < nbKeys; i++){
+            int value;
+            if (!concurrentHashtableGetValue(hashtable, tasks[t].keys[i], &value) || value != (int) i + 1)
+                errors++;
+        }
+        freeKeys(tasks[t].keys, nbKeys);
+    }
+    size_t numberOfPairs = concurrentHashtableNumberOfPairs(hashtable);
+    printf("%d threads, %zu pairs (expected %zu), %zu errors\n",
+           nbThreads, numberOfPairs, nbThreads*nbKeys, errors);
+    concurrentHashtableDestroy(hashtable);
+    printf("---- Fin test concurrent hash table stress ----\n");
+}
+
+/**
+ * @brief Benchmark: random reads and increments on keys shared by all the threads
+ */
+void* concurrentBenchmarkTask(void *argument){
+    ConcurrentTask *task = argument;
+    uint32_t state = task->seed;
+    int value;
+    for (size_t i = 0; i < task->nbOperations; i++){
+        string key = task->keys[xorshift32(&state) % task->nbKeys];
+        if (xorshift32(&state) % 100 < (uint32_t) task->readPercent)
+            concurrentHashtableGetValue(task->hashtable, key, &value);
+        else
+            concurrentHashtableAdd(task->hashtable, key, 1);
+    }
+    return NULL;
+}
+
+void testConcurrentThroughput(){
+    printf("---- Test concurrent hash table throughput ----\n");
+    size_t nbKeys = 100000;
+    size_t nbOperations = 2000000;
+    string *keys = createKeys(0, nbKeys);
+    int readPercents[3] = {50, 90, 99};
+    for (int r = 0; r < 3; r++){
+        for (int nbThreads = 1; nbThreads <= 8; nbThreads *= 2){
+            ConcurrentHashTable *hashtable = concurrentHashtableCreate(64, 1);
+            for (size_t i = 0; i < nbKeys; i++){
+                concurrentHashtableInsert(hashtable, keys[i], 0);
+            }
+            pthread_t threads[8];
+            ConcurrentTask tasks[8];
+            struct timespec start;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (int t = 0; t < nbThreads; t++){
+                tasks[t] = (ConcurrentTask) {hashtable, keys, nbKeys, readPercents[r],
+                                             nbOperations/nbThreads, 2463534242u + t, 0};
+                pthread_create(&threads[t], NULL, concurrentBenchmarkTask, &tasks[t]);
+            }
+            for (int t = 0; t < nbThreads; t++){
+                pthread_join(threads[t], NULL);
+            }
+            double t = elapsedNanoseconds(start)/1e9;
+            printf("%d%% reads, %d threads : %.2lf Mops/s\n", readPercents[r], nbThreads, nbOperations/t/1e6);
+            concurrentHashtableDestroy(hashtable);
+        }
+    }
+    freeKeys(keys, nbKeys);
+    printf("---- Fin test concurrent hash table throughput ----\n");
+}
+
+
+/**
+ * @brief Inserts nbKeys short keys in a table and destroys it, with or without arena.
+ * Prints the best times of the insertions and of the destruction over nbRuns runs.
+ */
+void benchmarkArena(string *keys, size_t nbKeys, HashTableEngine engine, int arena, int nbRuns){
+    double tInsert = 0, tDestroy = 0;
+    for (int run = 0; run < nbRuns; run++){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        HashTable table = hashtableCreateWithEngine(1, engine);
+        if (arena)
+            hashtableUseArena(&table, 0);
+        for (size_t i = 0; i < nbKeys; i++){
+            hashtableInsert(&table, keys[i], (int) i);
+        }
+        double t = elapsedNanoseconds(start)/1e9;
+        if (run == 0 || t < tInsert)
+            tInsert = t;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        hashtableDestroy(&table);
+        t = elapsedNanoseconds(start)/1e9;
+        if (run == 0 || t < tDestroy)
+            tDestroy = t;
+    }
+    printf("%s, %s : insert %.3lf s (%.0lf ns per key), destroy %.3lf s\n",
+           engine == HASHTABLE_CHAINING ? "chaining" : "open addressing",
+           arena ? "arena " : "malloc", tInsert, tInsert*1e9/nbKeys, tDestroy);
+}
+
+void testArena(){
+    printf("---- Test arena allocation ----\n");
+    size_t nbKeys = 2000000;
+    string *keys = createKeys(0, nbKeys);
+    for (int engine = HASHTABLE_CHAINING; engine <= HASHTABLE_OPEN_ADDRESSING; engine++){
+        benchmarkArena(keys, nbKeys, engine, 0, 5);
+        benchmarkArena(keys, nbKeys, engine, 1, 5);
+    }
+    freeKeys(keys, nbKeys);
+    printf("---- Fin test arena allocation ----\n");
+}
+
+
+/**
+ * @brief Hash function widehash64 truncated to its lowest 32 bits, for the benchmark
+ */
+uint32_t widehash64Low(string key, size_t sizeKey){
+    return (uint32_t) widehash64(key, sizeKey);
+}
+
+/**
+ * @brief Returns the time in ns per key of a hash function over nbRuns passes on the keys
+ */
+double benchmarkHashThroughput(HashFunction hashFunction, string *keys, size_t *sizes, size_t nbKeys, int nbRuns){
+    volatile uint32_t sink = 0;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int run = 0; run < nbRuns; run++){
+        uint32_t h = 0;
+        for (size_t i = 0; i < nbKeys; i++){
+            h ^= hashFunction(keys[i], sizes[i]);
+        }
+        sink ^= h;
+    }
+    (void) sink;
+    return elapsedNanoseconds(start)/nbRuns/nbKeys;
+}
+
+/**
+ * @brief Prints the quality of the distribution of the keys in nbBuckets lists:
+ * chi-squared divided by its expected value (close to 1 for a uniform hash),
+ * longest list and proportion of empty lists
+ */
+void benchmarkHashDistribution(HashFunction hashFunction, string *keys, size_t nbKeys, size_t nbBuckets, int mask){
+    size_t *counts = calloc(nbBuckets, sizeof(size_t));
+    for (size_t i = 0; i < nbKeys; i++){
+        uint32_t hash = hashFunction(keys[i], strlen(keys[i]));
+        counts[mask ? (hash & (nbBuckets - 1)) : hash % nbBuckets]++;
+    }
+    double expected = (double) nbKeys / nbBuckets;
+    double chi2 = 0;
+    size_t longest = 0, empty = 0;
+    for (size_t b = 0; b < nbBuckets; b++){
+        chi2 += (counts[b] - expected) * (counts[b] - expected) / expected;
+        if (counts[b] > longest)
+            longest = counts[b];
+        if (counts[b] == 0)
+            empty++;
+    }
+    printf("  %zu lists (%s) : chi2/(n-1) = %.3lf, longest list %zu, %.1lf%% empty lists\n",
+           nbBuckets, mask ? "mask" : "modulo", chi2/(nbBuckets - 1), longest, 100.0*empty/nbBuckets);
+    free(counts);
+}
+
+void testHashFunctions(){
+    printf("---- Test hash functions ----\n");
+    string *words;
+    size_t nbWords = loadBookWords(&words);
+    if (nbWords == 0)
+        return;
+    HashTable vocabulary = hashtableCreateWithHash(1024, HASHTABLE_OPEN_ADDRESSING, NULL);
+    for (size_t i = 0; i < nbWords; i++){
+        hashtableGetOrInsert(&vocabulary, words[i], 0, NULL);
+    }
+    size_t nbDistinct = 0;
+    string *distinct = malloc(sizeof(string)*vocabulary.numberOfPairs);
+    for (size_t i = 0; i < vocabulary.sizeTable; i++){
+        if (vocabulary.slots[i].key != NULL)
+            distinct[nbDistinct++] = vocabulary.slots[i].key;
+    }
+
+    /* keys of the book, and long keys of 256 bytes for the bulk throughput */
+    size_t *sizes = malloc(sizeof(size_t)*nbWords);
+    size_t totalSize = 0;
+    for (size_t i = 0; i < nbWords; i++){
+        sizes[i] = strlen(words[i]);
+        totalSize += sizes[i];
+    }
+    size_t nbLong = 4096;
+    string *longKeys = malloc(sizeof(string)*nbLong);
+    size_t *longSizes = malloc(sizeof(size_t)*nbLong);
+    for (size_t i = 0; i < nbLong; i++){
+        longKeys[i] = malloc(257);
+        for (int c = 0; c < 256; c++)
+            longKeys[i][c] = 'a' + (i*31 + c*7) % 26;
+        longKeys[i][256] = '\0';
+        longSizes[i] = 256;
+    }
+
+    char *names[3] = {"murmurhash32", "widehash32", "widehash64 (low 32 bits)"};
+    HashFunction functions[3] = {murmurhash32, widehash32, widehash64Low};
+    for (int f = 0; f < 3; f++){
+        double nsWord = benchmarkHashThroughput(functions[f], words, sizes, nbWords, 20);
+        double nsLong = benchmarkHashThroughput(functions[f], longKeys, longSizes, nbLong, 200);
+        printf("%s : book words %.1lf ns per key (%.0lf MB/s), keys of 256 bytes %.1lf ns per key (%.0lf MB/s)\n",
+               names[f], nsWord, totalSize/(nsWord*nbWords)*1e3, nsLong, 256/nsLong*1e3);
+        benchmarkHashDistribution(functions[f], distinct, nbDistinct, 1000, 0);
+        benchmarkHashDistribution(functions[f], distinct, nbDistinct, 1024, 1);
+        benchmarkHashDistribution(functions[f], distinct, nbDistinct, 65536, 1);
+    }
+
+    /* count of the words of the book: modulo and murmurhash32 against mask and widehash32 */
+    for (int f = 0; f < 2; f++){
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int run = 0; run < 10; run++){
+            HashTable table = f == 0 ? hashtableCreate(500) : hashtableCreateWithHash(500, HASHTABLE_CHAINING, widehash32);
+            for (size_t i = 0; i < nbWords; i++){
+                (*hashtableGetOrInsert(&table, words[i], 0, NULL))++;
+            }
+            hashtableDestroy(&table);
+        }
+        printf("count of the words, chaining, %s : %.1lf ms\n",
+               f == 0 ? "murmurhash32 and modulo" : "widehash32 and mask", elapsedNanoseconds(start)/10/1e6);
+    }
+
+    for (size_t i = 0; i < nbLong; i++)
+        free(longKeys[i]);
+    free(longKeys);
+    free(longSizes);
+    free(sizes);
+    free(distinct);
+    hashtableDestroy(&vocabulary);
+    for (size_t i = 0; i < nbWords; i++)
+        free(words[i]);
+    free(words);
+    printf("---- Fin test hash functions ----\n");
+}
+
 
 int main() {
 /*
@@ -218,6 +831,15 @@ int main() {
     testHashtableRemove();
   */
      testCountDistinctWordsInBook();
+     testCompareEngines();
+     testIncrementalResize();
+     testLookupStats();
+     testCountWordsThroughput();
+     testCountWordsParallel();
+     testConcurrentStress();
+     testConcurrentThroughput();
+     testArena();
+     testHashFunctions();
 
 
     return 0;
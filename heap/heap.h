@@ -4,6 +4,9 @@
  *        functions for creating, modifying, and removing elements from the heap.
  */
 
+#ifndef HEAP_H
+#define HEAP_H
+
 /**
  * @struct Heap
  * @brief The Heap data structure that represents a priority queue.
@@ -69,3 +72,5 @@ void modifyPriorityHeap(Heap *h, int element, double priority);
  * @return The element with the smallest priority (smallest value in the priority array) that was removed from the Heap data structure.
  */
 int removeElement(Heap *h);
+
+#endif  // HEAP_H
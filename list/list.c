@@ -222,6 +222,7 @@ List delKeyInList(List L, string key) {
     Cell* newCell;
     newCell = malloc(sizeof(Cell));
     newCell->value = value;
+    newCell->hash = 0;
     newCell->key = NULL;
     newCell->nextCell = NULL;
     if (key != NULL){
@@ -244,3 +245,199 @@ List delKeyInList(List L, string key) {
 }
 
 
+
+
+/**
+ * @brief Alignment of the memory given by an arena
+ */
+#define ARENA_ALIGNMENT 16
+
+/**
+ * @brief Default number of bytes of the blocks of an arena
+ */
+#define ARENA_DEFAULT_BLOCK_SIZE 65536
+
+/**
+ * @brief Size of the header of a block, rounded up to the alignment
+ */
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+/**
+ * @brief Creates a new empty arena
+ *
+ * @param blockSize Number of bytes of the blocks (0 for the default size of 64 KiB)
+ *
+ * @return A pointer to the new arena
+ */
+Arena* newArena(size_t blockSize) {
+    Arena *A;
+    A = malloc(sizeof(Arena));
+    A->blocks = NULL;
+    A->blockSize = blockSize > 0 ? blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+    A->freeCells = NULL;
+    return A;
+}
+
+/**
+ * @brief Frees an arena and all the cells and keys allocated in it
+ *
+ * @param A Pointer to the arena to be freed
+ */
+void freeArena(Arena *A) {
+    ArenaBlock *block;
+    if (!A){
+        return;
+    }
+    while (A->blocks != NULL){
+        block = A->blocks;
+        A->blocks = block->next;
+        free(block);
+    }
+    free(A);
+}
+
+/**
+ * @brief Allocates memory in an arena
+ *
+ * @param A Pointer to the arena
+ * @param size Number of bytes to allocate
+ *
+ * @return A pointer to the memory, suitably aligned for any cell
+ *
+ * A request larger than the block size gets its own block, placed behind
+ * the current block so that the free space of the current block is kept.
+ */
+void* arenaAlloc(Arena *A, size_t size) {
+    ArenaBlock *block;
+    char *memory;
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    block = A->blocks;
+    if (block == NULL || block->used + size > block->size){
+        if (size > A->blockSize){
+            block = malloc(ARENA_HEADER_SIZE + size);
+            block->size = size;
+            block->used = 0;
+            if (A->blocks == NULL){
+                block->next = NULL;
+                A->blocks = block;
+            }
+            else {
+                block->next = A->blocks->next;
+                A->blocks->next = block;
+            }
+        }
+        else {
+            block = malloc(ARENA_HEADER_SIZE + A->blockSize);
+            block->size = A->blockSize;
+            block->used = 0;
+            block->next = A->blocks;
+            A->blocks = block;
+        }
+    }
+    memory = (char*) block + ARENA_HEADER_SIZE + block->used;
+    block->used += size;
+    return memory;
+}
+
+/**
+ * @brief Copies a key (of length sizeKey, not necessarily ended by '\0') in an arena
+ *
+ * @return A pointer to the copy ended by '\0'
+ */
+string arenaCopyKey(Arena *A, const char *key, size_t sizeKey) {
+    string copy;
+    copy = arenaAlloc(A, sizeKey + 1);
+    memcpy(copy, key, sizeKey);
+    copy[sizeKey] = '\0';
+    return copy;
+}
+
+/**
+ * @brief Allocates a cell in an arena, reusing a cell given back if any
+ *
+ * @param A Pointer to the arena
+ *
+ * @return A pointer to a cell with a NULL key, a NULL next cell and null value and hash
+ */
+Cell* arenaNewCell(Arena *A) {
+    Cell *newCell;
+    if (A->freeCells != NULL){
+        newCell = A->freeCells;
+        A->freeCells = newCell->nextCell;
+    }
+    else {
+        newCell = arenaAlloc(A, sizeof(Cell));
+    }
+    newCell->key = NULL;
+    newCell->value = 0;
+    newCell->hash = 0;
+    newCell->nextCell = NULL;
+    return newCell;
+}
+
+/**
+ * @brief Gives a cell back to its arena. Its key is freed with the arena.
+ *
+ * @param A Pointer to the arena
+ * @param cell Cell to give back
+ */
+void arenaReleaseCell(Arena *A, Cell *cell) {
+    cell->nextCell = A->freeCells;
+    A->freeCells = cell;
+}
+
+/**
+ * @brief Adds a key-value pair to a linked list whose cells and keys belong to an arena
+ *
+ * @param L Pointer to the linked list to add to
+ * @param key Key to add
+ * @param value Value to add
+ * @param A Arena owning the cells of the list, NULL to allocate the cell as addKeyValueInList
+ *
+ * @return A pointer to the modified linked list
+ *
+ * The key-value pair is added at the beginning of the list.
+ * A list allocated in an arena must not be freed by freeList but by freeArena.
+ */
+List addKeyValueInListArena(List L, string key, int value, Arena *A) {
+    Cell *newCell;
+    if (A == NULL){
+        return addKeyValueInList(L, key, value);
+    }
+    newCell = arenaNewCell(A);
+    newCell->value = value;
+    if (key != NULL){
+        newCell->key = arenaCopyKey(A, key, strlen(key));
+    }
+    newCell->nextCell = L;
+    return newCell;
+}
+
+/**
+ * @brief Deletes a key from a linked list whose cells and keys belong to an arena
+ *
+ * @param L Pointer to the linked list to search in
+ * @param key Key to delete
+ * @param A Arena owning the cells of the list, NULL to free the cell as delKeyInList
+ *
+ * @return A pointer to the modified linked list
+ *
+ * Only the first occurrence of the key is deleted.
+ */
+List delKeyInListArena(List L, string key, Arena *A) {
+    Cell **link;
+    Cell *target;
+    if (A == NULL){
+        return delKeyInList(L, key);
+    }
+    link = &L;
+    while (*link != NULL && ((*link)->key == NULL || strcmp((*link)->key, key) != 0)){
+        link = &(*link)->nextCell;
+    }
+    if (*link != NULL){
+        target = *link;
+        *link = target->nextCell;
+        arenaReleaseCell(A, target);
+    }
+    return L;
+}
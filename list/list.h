@@ -12,6 +12,8 @@
 #ifndef LIST_H_INCLUDED
 #define LIST_H_INCLUDED
 
+#include <stddef.h>
+
 /**
  * @brief Definition of the type string
  *
@@ -22,15 +24,41 @@ typedef char *string;
  * @brief Definition of a linked list cell and a linked list
  *
  * The structure contains the key (a string), the value (an integer),
+ * the full hash of the key when the cell belongs to a hash table,
  * and a pointer to the next cell in the list.
  * A linked list is just a pointer on the first cell (if it exists).
  */
 typedef struct cell{
     string key; /**< Key of the cell */
     int value; /**< Value of the cell */
+    unsigned int hash; /**< Full hash of the key, set by the hash tables (0 otherwise) */
     struct cell *nextCell; /**< Pointer to the next cell in the list */
 } Cell, *List;
 
+/**
+ * @brief Definition of a block of memory of an arena
+ *
+ * The bytes of the block follow the header.
+ */
+typedef struct arenaBlock{
+    struct arenaBlock *next; /**< Previously allocated block */
+    size_t size; /**< Number of bytes of the block */
+    size_t used; /**< Number of bytes already given */
+} ArenaBlock;
+
+/**
+ * @brief Definition of an arena owning cells and keys
+ *
+ * The cells and the keys allocated in an arena are carved from large blocks
+ * and are all freed at once by freeArena. A cell given back to the arena
+ * is reused by the next allocation of a cell.
+ */
+typedef struct arena{
+    ArenaBlock *blocks; /**< Current block, linked to the previous ones */
+    size_t blockSize; /**< Number of bytes of a new block */
+    Cell *freeCells; /**< Cells given back to the arena */
+} Arena;
+
 
 /**
  * @brief Creates a new empty linked list
@@ -94,6 +122,83 @@ List delKeyInList(List L, string key);
  */
 List addKeyValueInList(List L, string key, int value);
 
+/**
+ * @brief Creates a new empty arena
+ *
+ * @param blockSize Number of bytes of the blocks (0 for the default size of 64 KiB)
+ *
+ * @return A pointer to the new arena
+ */
+Arena* newArena(size_t blockSize);
+
+/**
+ * @brief Frees an arena and all the cells and keys allocated in it
+ *
+ * @param A Pointer to the arena to be freed
+ */
+void freeArena(Arena *A);
+
+/**
+ * @brief Allocates memory in an arena
+ *
+ * @param A Pointer to the arena
+ * @param size Number of bytes to allocate
+ *
+ * @return A pointer to the memory, suitably aligned for any cell
+ */
+void* arenaAlloc(Arena *A, size_t size);
+
+/**
+ * @brief Copies a key (of length sizeKey, not necessarily ended by '\0') in an arena
+ *
+ * @return A pointer to the copy ended by '\0'
+ */
+string arenaCopyKey(Arena *A, const char *key, size_t sizeKey);
+
+/**
+ * @brief Allocates a cell in an arena, reusing a cell given back if any
+ *
+ * @param A Pointer to the arena
+ *
+ * @return A pointer to a cell with a NULL key, a NULL next cell and null value and hash
+ */
+Cell* arenaNewCell(Arena *A);
+
+/**
+ * @brief Gives a cell back to its arena. Its key is freed with the arena.
+ *
+ * @param A Pointer to the arena
+ * @param cell Cell to give back
+ */
+void arenaReleaseCell(Arena *A, Cell *cell);
+
+/**
+ * @brief Adds a key-value pair to a linked list whose cells and keys belong to an arena
+ *
+ * @param L Pointer to the linked list to add to
+ * @param key Key to add
+ * @param value Value to add
+ * @param A Arena owning the cells of the list, NULL to allocate the cell as addKeyValueInList
+ *
+ * @return A pointer to the modified linked list
+ *
+ * A list allocated in an arena must not be freed by freeList but by freeArena.
+ */
+List addKeyValueInListArena(List L, string key, int value, Arena *A);
+
+/**
+ * @brief Deletes a key from a linked list whose cells and keys belong to an arena
+ *
+ * @param L Pointer to the linked list to search in
+ * @param key Key to delete
+ * @param A Arena owning the cells of the list, NULL to free the cell as delKeyInList
+ *
+ * @return A pointer to the modified linked list
+ *
+ * Only the first occurrence of the key is deleted.
+ */
+List delKeyInListArena(List L, string key, Arena *A);
+
 
 #endif
 /* LIST_H_INCLUDED */
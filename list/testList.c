@@ -15,6 +15,8 @@
 int main() {
     List L;
     Cell *c;
+    Arena *A;
+    List LA;
     L = newList();
     printf("Is the list NULL (0=NO, 1=YES)? %d\n", L==NULL);
     printf("Print empty list:");
@@ -82,5 +84,19 @@ int main() {
     printf("three: ");printList(L,1);printf("\n");
     
     freeList(L);
+
+    printf("\nTest lists in an arena:\n");
+    A = newArena(64);
+    LA = newList();
+    LA = addKeyValueInListArena(LA, "one", 1, A);
+    LA = addKeyValueInListArena(LA, "two", 2, A);
+    LA = addKeyValueInListArena(LA, "a key longer than the blocks of the arena", 3, A);
+    printList(LA,1); printf("\n");
+    LA = delKeyInListArena(LA, "two", A);
+    printf("two: ");printList(LA,1);printf("\n");
+    LA = addKeyValueInListArena(LA, "four", 4, A);
+    printf("Is the deleted cell reused (0=NO, 1=YES)? %d\n", A->freeCells == NULL);
+    printList(LA,1); printf("\n");
+    freeArena(A);
     return 0;
 }
@@ -66,6 +66,7 @@ void enqueue(Queue* q, int data) {
     cell = malloc(sizeof(Cell));
     cell->value = data;
     cell->key = NULL;
+    cell->hash = 0;
     cell ->nextCell = NULL;
     if (isQueueEmpty(*q) == 1){
         q->front = cell;
@@ -149,6 +149,18 @@ RBinarySearchTree insertAtRoot(RBinarySearchTree tree, int value) {
  * @return A pointer to the root of the modified tree.
  */
 RBinarySearchTree addToRBST(RBinarySearchTree tree, int value){
+    return addToRBSTWithGenerator(tree, value, rngDefault());
+}
+
+
+/**
+ * @brief Add a value to a binary search tree, with the random choices drawn from a given generator.
+ * @param tree Pointer to the root of the tree.
+ * @param value The value to add.
+ * @param generator The generator.
+ * @return A pointer to the root of the modified tree.
+ */
+RBinarySearchTree addToRBSTWithGenerator(RBinarySearchTree tree, int value, RandomGenerator *generator){
     static int add = 0;
     if (!tree){
         RBinarySearchTree node;
@@ -161,15 +173,13 @@ RBinarySearchTree addToRBST(RBinarySearchTree tree, int value){
         return node;
 
     }
-    //srand(time(NULL));
-    int p;
-    p = rand()%101;
-    if ((1.0/(tree->size+1)) < p/100.0){
+    // insertion at the root with probability exactly 1/(size+1)
+    if (rngBounded(generator, tree->size+1) != 0){
         if (value > tree->value){
-            tree->rightRBST = addToRBST(tree->rightRBST, value);
+            tree->rightRBST = addToRBSTWithGenerator(tree->rightRBST, value, generator);
         }
         if (value < tree->value){
-            tree->leftRBST = addToRBST(tree->leftRBST,value);
+            tree->leftRBST = addToRBSTWithGenerator(tree->leftRBST, value, generator);
         }
         //update the size to do
         if (add==1) tree->size++;
@@ -13,6 +13,8 @@
 #ifndef RBST_H_INCLUDED
 #define RBST_H_INCLUDED
 
+#include "../utils/rng.h"
+
 
 
 /**
@@ -87,6 +89,17 @@ RBinarySearchTree insertAtRoot(RBinarySearchTree tree, int value);
  */
 RBinarySearchTree addToRBST(RBinarySearchTree tree, int value);
 
+/**
+ * @brief Add a value to a binary search tree, with the random choices drawn from a given generator.
+ * @param tree Pointer to the root of the tree.
+ * @param value The value to add.
+ * @param generator The generator. addToRBST uses the shared generator rngDefault().
+ * @return A pointer to the root of the modified tree.
+ *
+ * In a tree of size n, the value is inserted at the root with probability 1/(n+1).
+ */
+RBinarySearchTree addToRBSTWithGenerator(RBinarySearchTree tree, int value, RandomGenerator *generator);
+
 /**
  * @brief Compute the height of a binary search tree.
  * @param tree Pointer to the root of the tree.
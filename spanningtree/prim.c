@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "../graph/graph.h"
+#include "../graph/csrgraph.h"
 #include "../heap/heap.h"
 #define INFINITY 2.00 /* we will never have distance(u,v) >= 2 because we are in
                         [0,1]x[0,1]*/
@@ -36,31 +37,59 @@
         while (tmp){
             int v;
             v = tmp->value;
-            if ( ( heap->position[v] != -1 ) && ( heap->priority[v] > 
-                                                distance(g.xCoordinates[minVertexFromHeap],
-                                                g.yCoordinates[minVertexFromHeap],
-                                                g.xCoordinates[v],
-                                                g.yCoordinates[v]) )
-                    
-              ){
-                g.parents[v] = minVertexFromHeap ;
-                modifyPriorityHeap(heap, v,distance(g.xCoordinates[minVertexFromHeap],
-                                                    g.yCoordinates[minVertexFromHeap],
-                                                    g.xCoordinates[v],
-                                                    g.yCoordinates[v])) ;
-
-
+            /* the distance is computed only for the vertices still in the heap, and only once */
+            if ( heap->position[v] != -1 ){
+                double weight = distance(g.xCoordinates[minVertexFromHeap],
+                                         g.yCoordinates[minVertexFromHeap],
+                                         g.xCoordinates[v],
+                                         g.yCoordinates[v]);
+                if ( heap->priority[v] > weight ){
+                    g.parents[v] = minVertexFromHeap ;
+                    modifyPriorityHeap(heap, v, weight) ;
+                }
             }
         tmp = tmp->nextCell ;
         }
     }
-    
-    
-
-    
-
-
+    free(heap->position);
+    free(heap->priority);
+    free(heap->heap);
+    free(heap);
     return;
 
  }
 
+
+/**
+ * @brief Function that computes a minimum spanning tree of a weighted graph in CSR format of the connex component of the vertex s
+ *
+ * @param graph The graph, its weights are supposed not to be NULL
+ * @param s Index of the initial vertex of the Prim procedure.
+ *
+ * Same as Prim, the weight of an edge being read in the array weights instead of
+ * being computed from the coordinates.
+ * Note that the array parents must be initialized before calling the function.
+ */
+ void csrPrim(CSRGraph graph, int s){
+    Heap* heap;
+    heap = createHeap(graph.numberVertices) ;
+    for (int i = 0; i<graph.numberVertices; i++){
+        insertHeap(heap, i, INFINITY) ;
+    }
+    modifyPriorityHeap(heap, s, 0.00);
+    graph.parents[s] = s;
+    while (heap->nbElements){
+        int minVertexFromHeap = removeElement(heap);
+        for (int e = graph.offsets[minVertexFromHeap]; e < graph.offsets[minVertexFromHeap+1]; e++){
+            int v = graph.targets[e];
+            if ( heap->position[v] != -1 && heap->priority[v] > graph.weights[e] ){
+                graph.parents[v] = minVertexFromHeap ;
+                modifyPriorityHeap(heap, v, graph.weights[e]) ;
+            }
+        }
+    }
+    free(heap->position);
+    free(heap->priority);
+    free(heap->heap);
+    free(heap);
+ }
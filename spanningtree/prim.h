@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "../graph/graph.h"
+#include "../graph/csrgraph.h"
 
 /**
  * @brief Function that computes a minimum spanning tree of graph g of the connex component of the vertex s
@@ -23,6 +24,18 @@
  */
  void Prim(Graph g, int s);
 
+/**
+ * @brief Function that computes a minimum spanning tree of a weighted graph in CSR format of the connex component of the vertex s
+ *
+ * @param graph The graph, its weights are supposed not to be NULL
+ * @param s Index of the initial vertex of the Prim procedure.
+ *
+ * Same as Prim, the weight of an edge being read in the array weights instead of
+ * being computed from the coordinates.
+ * Note that the array parents must be initialized before calling the function.
+ */
+ void csrPrim(CSRGraph graph, int s);
+
 
 
 
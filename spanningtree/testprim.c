@@ -1,9 +1,131 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #include "../graph/graph.h"
 #include "prim.h"
+#include "../graph/csrgraph.h"
 #include "time.h"
 
+/**
+ * @brief Returns the time elapsed since start in seconds
+ */
+double elapsedSeconds(struct timespec start){
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec)/1e9;
+}
+
+/**
+ * @brief Total length of a spanning tree given by the parents of the vertices
+ */
+double treeWeight(Graph graph, int *parents){
+    double weight = 0;
+    for (int v = 0; v<graph.numberVertices; v++){
+        int p = parents[v];
+        if (p >= 0)
+            weight += distance(graph.xCoordinates[v], graph.yCoordinates[v], graph.xCoordinates[p], graph.yCoordinates[p]);
+    }
+    return weight;
+}
+
+/**
+ * @brief Compares Prim on a graph of adjacency lists and on the same graph in CSR format
+ */
+void testCSRPrim(){
+    printf("---- Test Prim on a CSR graph ----\n");
+    int n = 1000000;
+    Graph graph = createGraphWithoutEdges(n, 0, rngDefault());
+    for (int i = 0; i<n; i++){
+        for (int k = 0; k<4; k++){
+            int j = rand() % n;
+            if (j != i){
+                addEdgeInGraph(graph, i, j);
+                addEdgeInGraph(graph, j, i);
+            }
+        }
+    }
+    CSRGraph csr = createCSRGraphFromGraph(graph, 1);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Prim(graph, 0);
+    double tList = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    csrPrim(csr, 0);
+    double tCSR = elapsedSeconds(start);
+    int same = 1;
+    for (int i = 0; i<n; i++){
+        if (graph.parents[i] != csr.parents[i])
+            same = 0;
+    }
+    printf("%d vertices, %d edges : lists %.3lf s (%.1lf Medges/s), CSR %.3lf s (%.1lf Medges/s), %s parents\n",
+           n, csr.numberEdges, tList, csr.numberEdges/tList/1e6, tCSR, csr.numberEdges/tCSR/1e6, same ? "same" : "DIFFERENT");
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test Prim on a CSR graph ----\n");
+}
+
+/**
+ * @brief Measures the distances saved by the weights computed once in a dense graph
+ */
+void testPrecomputedWeights(){
+    printf("---- Test precomputed weights ----\n");
+    int n = 20000;
+    double sigma = 0.1;
+    RandomGenerator generator;
+    rngSeed(&generator, 21);
+    Graph graph = createGraphWithGenerator(0, n, sigma, &generator);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CSRGraph csr = createCSRGraphFromGraph(graph, 1);
+    double tWeights = elapsedSeconds(start);
+    /* the work of distance() alone: the sum of the lengths of the edges */
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double sumDistances = 0;
+    for (int v = 0; v<n; v++){
+        for (int e = csr.offsets[v]; e < csr.offsets[v+1]; e++){
+            int j = csr.targets[e];
+            sumDistances += distance(graph.xCoordinates[v], graph.yCoordinates[v], graph.xCoordinates[j], graph.yCoordinates[j]);
+        }
+    }
+    double tDistances = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    double sumWeights = 0;
+    for (int e = 0; e < csr.numberEdges; e++){
+        sumWeights += csr.weights[e];
+    }
+    double tRead = elapsedSeconds(start);
+    printf("%d vertices, %d edges, weights of %zu bytes computed in %.3lf s\n", n, csr.numberEdges, sizeof(EdgeWeight), tWeights);
+    printf("sum of the lengths : distance() %.3lf s (%.1lf ns per edge), weights %.3lf s (%.1lf ns per edge), %s sum\n",
+           tDistances, tDistances/csr.numberEdges*1e9, tRead, tRead/csr.numberEdges*1e9,
+           fabs(sumDistances - sumWeights) <= 1e-6*sumDistances ? "same" : "DIFFERENT");
+    for (int i = 0; i<n; i++)
+        graph.parents[i] = -1;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Prim(graph, 0);
+    double tList = elapsedSeconds(start);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    csrPrim(csr, 0);
+    double tCSR = elapsedSeconds(start);
+    if (sizeof(EdgeWeight) == sizeof(double)){
+        int same = 1;
+        for (int i = 0; i<n; i++){
+            if (graph.parents[i] != csr.parents[i])
+                same = 0;
+        }
+        printf("Prim : lists and distance() %.3lf s, CSR and weights %.3lf s, %s parents\n", tList, tCSR,
+               same ? "same" : "DIFFERENT");
+    } else {
+        /* rounded weights may break the ties differently: only the total weights are comparable */
+        double weightList = treeWeight(graph, graph.parents);
+        double weightCSR = treeWeight(graph, csr.parents);
+        printf("Prim : lists and distance() %.3lf s, CSR and weights %.3lf s, %s tree weight (%.6lf and %.6lf)\n", tList, tCSR,
+               fabs(weightList - weightCSR) <= 1e-5*weightList ? "same" : "DIFFERENT", weightList, weightCSR);
+    }
+    freeCSRGraph(&csr);
+    freeGraph(graph);
+    printf("---- Fin test precomputed weights ----\n");
+}
+
 int main() {
     srand(time(NULL));
     // Create a graph
@@ -30,6 +152,8 @@ int main() {
     drawGraph(graph, "prim-graph-tree.svg",2,0);
     drawGraph(graph, "prim-tree.svg",1,0);
 
+    testCSRPrim();
+    testPrecomputedWeights();
 
     return 0;
 }
@@ -16,6 +16,11 @@
 #include "unit_test_hashtableHasKey.c"
 #include "unit_test_hashtableGetValue.c"
 #include "unit_test_hashtableRemove.c"
+#include "unit_test_hashtableOpenAddressing.c"
+#include "unit_test_hashtableIncrementalResize.c"
+#include "unit_test_hashtableGetOrInsert.c"
+#include "unit_test_hashtableArena.c"
+#include "unit_test_hashtableHashFunction.c"
 
 
 
@@ -32,6 +37,11 @@ int main() {
     int score6 = 0;
     int score7 = 0;
     int score8 = 0;
+    int score9 = 0;
+    int score10 = 0;
+    int score11 = 0;
+    int score12 = 0;
+    int score13 = 0;
 
     printf("------------------------------------------------------\n");
     printf("Unit test for HashTable \n");
@@ -53,6 +63,16 @@ int main() {
         score7 = test_hashtableGetValue();
     if(score7==2)
         score8 = test_hashtableRemove();
+    if(score8==2)
+        score9 = test_hashtableOpenAddressing();
+    if(score9==2)
+        score10 = test_hashtableIncrementalResize();
+    if(score10==2)
+        score11 = test_hashtableGetOrInsert();
+    if(score11==3)
+        score12 = test_hashtableArena();
+    if(score12==3)
+        score13 = test_hashtableHashFunction();
 
     system("rm -f output.txt");
     printf("-----------------------------------\n");
@@ -66,6 +86,11 @@ int main() {
     printf("Summary: %d passed tests over 2 tests for hashtableHasKey().\n",score6);
     printf("Summary: %d passed tests over 2 tests for hashtableGetValue().\n",score7);
     printf("Summary: %d passed tests over 2 tests for hashtableRemove().\n",score8);
+    printf("Summary: %d passed tests over 2 tests for the open addressing engine.\n",score9);
+    printf("Summary: %d passed tests over 2 tests for the incremental resize.\n",score10);
+    printf("Summary: %d passed tests over 3 tests for hashtableGetOrInsert().\n",score11);
+    printf("Summary: %d passed tests over 3 tests for hashtableUseArena().\n",score12);
+    printf("Summary: %d passed tests over 3 tests for hashtableCreateWithHash().\n",score13);
 
 
     return 0;
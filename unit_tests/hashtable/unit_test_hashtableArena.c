@@ -0,0 +1,82 @@
+int test_hashtableArena_engine(HashTableEngine engine){
+    int n = 1000+rand()%2000;
+    int nbKeys = 600;
+
+    printf("** Insert and remove %d random pairs (key,value) among %d different keys in a %s hashtable of size 1 allocated in an arena.\n",n,nbKeys,
+            engine==HASHTABLE_CHAINING ? "chaining" : "open addressing");
+    int tabValue[nbKeys];
+    for(int i=0;i<nbKeys;i++)
+        tabValue[i]=-1;
+    char key[20];
+    HashTable h = hashtableCreateWithEngine(1,engine);
+    hashtableUseArena(&h,256);
+    if(h.arena==NULL){
+        printf("Failed: hashtableUseArena does not create the arena of an empty hashtable.\n");
+        return 0;
+    }
+
+    size_t nbOfPairs =0;
+    for(int i=0;i<n;i++){
+        int r = rand()%nbKeys;
+        sprintf(key,"key %d",r);
+        if(rand()%4==0){
+            if(tabValue[r]!=-1){
+                hashtableRemove(&h,key);
+                nbOfPairs--;
+                tabValue[r]=-1;
+            }
+        }
+        else{
+            if(tabValue[r]==-1)
+                nbOfPairs++;
+            tabValue[r]=rand()%1000;
+            hashtableInsert(&h,key,tabValue[r]);
+        }
+    }
+    if(h.numberOfPairs != nbOfPairs){
+        printf("Failed : the number of pairs in the hashtable (%zu) is different from the expected number of pairs (%zu).\n", h.numberOfPairs, nbOfPairs);
+        return 0;
+    }
+    HashTable h2 = hashtableDoubleSize(h);
+    for(int i=0;i<nbKeys;i++){
+        sprintf(key,"key %d",i);
+        if(hashtableHasKey(h,key)!=(tabValue[i]!=-1) || hashtableHasKey(h2,key)!=(tabValue[i]!=-1)){
+            printf("Failed: hashtableHasKey gives a wrong answer for key '%s'.\n",key);
+            return 0;
+        }
+        if(tabValue[i]!=-1 && (hashtableGetValue(h,key)!=tabValue[i] || hashtableGetValue(h2,key)!=tabValue[i])){
+            printf("Failed: hashtableGetValue gives a wrong value for key '%s'.\n",key);
+            return 0;
+        }
+    }
+
+    hashtableDestroy(&h);
+    hashtableDestroy(&h2);
+    if(h.arena!=NULL){
+        printf("Failed: hashtableDestroy does not free the arena.\n");
+        return 0;
+    }
+    printf("Passed!\n");
+    return 1;
+}
+
+int test_hashtableArena_results(){
+    int score = test_hashtableArena_engine(HASHTABLE_CHAINING);
+    score += test_hashtableArena_engine(HASHTABLE_OPEN_ADDRESSING);
+    return score;
+}
+
+int test_hashtableArena_vg(){
+    int score=valgrind_test("hashtableArena","","Memory test for hashtableUseArena");
+    return score;
+}
+
+int test_hashtableArena(){
+    printf("----------------------------------------------\n");
+    printf("Unit tests for hashtableUseArena \n");
+    printf("----------------------------------------------\n");
+
+    int score = test_hashtableArena_results();
+    score+=test_hashtableArena_vg();
+    return score;
+}
@@ -0,0 +1,72 @@
+int test_hashtableGetOrInsert_engine(HashTableEngine engine){
+    int n = 1000+rand()%2000;
+    int nbKeys = 600;
+
+    printf("** Count %d random keys among %d different keys with hashtableGetOrInsert in a %s hashtable of size 1.\n",n,nbKeys,
+            engine==HASHTABLE_CHAINING ? "chaining" : "open addressing");
+    int tabCount[nbKeys];
+    for(int i=0;i<nbKeys;i++)
+        tabCount[i]=0;
+    char key[20];
+    HashTable h = hashtableCreateWithEngine(1,engine);
+
+    size_t nbOfPairs =0;
+    for(int i=0;i<n;i++){
+        int r = rand()%nbKeys;
+        sprintf(key,"key %d",r);
+        int inserted;
+        int *count = hashtableGetOrInsert(&h,key,0,&inserted);
+        if(inserted != (tabCount[r]==0)){
+            printf("Failed: hashtableGetOrInsert sets inserted to %d for key '%s'.\n",inserted,key);
+            return 0;
+        }
+        if(count==NULL || *count!=tabCount[r]){
+            printf("Failed: hashtableGetOrInsert returns a wrong value for key '%s'.\n",key);
+            return 0;
+        }
+        if(inserted)
+            nbOfPairs++;
+        (*count)++;
+        tabCount[r]++;
+    }
+    if(h.numberOfPairs != nbOfPairs){
+        printf("Failed : the number of pairs in the hashtable (%zu) is different from the expected number of pairs (%zu).\n", h.numberOfPairs, nbOfPairs);
+        return 0;
+    }
+    for(int i=0;i<nbKeys;i++){
+        sprintf(key,"key %d",i);
+        if(hashtableHasKey(h,key)!=(tabCount[i]!=0)){
+            printf("Failed: hashtableHasKey gives a wrong answer for key '%s'.\n",key);
+            return 0;
+        }
+        if(tabCount[i]!=0 && hashtableGetValue(h,key)!=tabCount[i]){
+            printf("Failed: the value updated through the pointer is wrong for key '%s'.\n",key);
+            return 0;
+        }
+    }
+
+    hashtableDestroy(&h);
+    printf("Passed!\n");
+    return 1;
+}
+
+int test_hashtableGetOrInsert_results(){
+    int score = test_hashtableGetOrInsert_engine(HASHTABLE_CHAINING);
+    score += test_hashtableGetOrInsert_engine(HASHTABLE_OPEN_ADDRESSING);
+    return score;
+}
+
+int test_hashtableGetOrInsert_vg(){
+    int score=valgrind_test("hashtableGetOrInsert","","Memory test for hashtableGetOrInsert");
+    return score;
+}
+
+int test_hashtableGetOrInsert(){
+    printf("----------------------------------------------\n");
+    printf("Unit tests for hashtableGetOrInsert \n");
+    printf("----------------------------------------------\n");
+
+    int score = test_hashtableGetOrInsert_results();
+    score+=test_hashtableGetOrInsert_vg();
+    return score;
+}
@@ -0,0 +1,87 @@
+int test_hashtableHashFunction_engine(HashTableEngine engine){
+    int n = 1000+rand()%2000;
+    int nbKeys = 600;
+
+    printf("** Insert and remove %d random pairs (key,value) among %d different keys in a %s hashtable of size 3 hashed by widehash32.\n",n,nbKeys,
+            engine==HASHTABLE_CHAINING ? "chaining" : "open addressing");
+    int tabValue[nbKeys];
+    for(int i=0;i<nbKeys;i++)
+        tabValue[i]=-1;
+    char key[20];
+    HashTable h = hashtableCreateWithHash(3,engine,widehash32);
+    if(h.hashFunction!=widehash32 || (h.sizeTable & (h.sizeTable-1))!=0){
+        printf("Failed: hashtableCreateWithHash does not set the hash function or a power of two size (%zu).\n",h.sizeTable);
+        return 0;
+    }
+
+    size_t nbOfPairs =0;
+    for(int i=0;i<n;i++){
+        int r = rand()%nbKeys;
+        sprintf(key,"key %d",r);
+        if(rand()%4==0){
+            if(tabValue[r]!=-1){
+                hashtableRemove(&h,key);
+                nbOfPairs--;
+                tabValue[r]=-1;
+            }
+        }
+        else{
+            if(tabValue[r]==-1)
+                nbOfPairs++;
+            tabValue[r]=rand()%1000;
+            hashtableInsert(&h,key,tabValue[r]);
+        }
+    }
+    if(h.numberOfPairs != nbOfPairs || (h.sizeTable & (h.sizeTable-1))!=0){
+        printf("Failed : the hashtable has %zu pairs (expected %zu) and a size %zu.\n", h.numberOfPairs, nbOfPairs, h.sizeTable);
+        return 0;
+    }
+    for(int i=0;i<nbKeys;i++){
+        sprintf(key,"key %d",i);
+        if(hashtableHasKey(h,key)!=(tabValue[i]!=-1)){
+            printf("Failed: hashtableHasKey gives a wrong answer for key '%s'.\n",key);
+            return 0;
+        }
+        if(tabValue[i]==-1)
+            continue;
+        if(hashtableGetValue(h,key)!=tabValue[i]){
+            printf("Failed: hashtableGetValue gives a wrong value for key '%s'.\n",key);
+            return 0;
+        }
+        if(engine==HASHTABLE_CHAINING){
+            size_t hache = widehash32(key,strlen(key)) & (h.sizeTable-1);
+            Cell* cell = h.table[hache];
+            while(cell!=NULL && strcmp(cell->key,key)!=0)
+                cell = cell->nextCell;
+            if(cell==NULL){
+                printf("Failed: the key '%s' is not in the list given by the mask of its hash.\n",key);
+                return 0;
+            }
+        }
+    }
+
+    hashtableDestroy(&h);
+    printf("Passed!\n");
+    return 1;
+}
+
+int test_hashtableHashFunction_results(){
+    int score = test_hashtableHashFunction_engine(HASHTABLE_CHAINING);
+    score += test_hashtableHashFunction_engine(HASHTABLE_OPEN_ADDRESSING);
+    return score;
+}
+
+int test_hashtableHashFunction_vg(){
+    int score=valgrind_test("hashtableHashFunction","","Memory test for hashtableCreateWithHash");
+    return score;
+}
+
+int test_hashtableHashFunction(){
+    printf("----------------------------------------------\n");
+    printf("Unit tests for hashtableCreateWithHash \n");
+    printf("----------------------------------------------\n");
+
+    int score = test_hashtableHashFunction_results();
+    score+=test_hashtableHashFunction_vg();
+    return score;
+}
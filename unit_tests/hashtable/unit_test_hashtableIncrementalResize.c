@@ -0,0 +1,80 @@
+int test_hashtableIncrementalResize_results(){
+    int n = 1000+rand()%2000;
+    int nbKeys = 600;
+
+    printf("** Insert and remove %d random pairs (key,value) in a hashtable of size 1 with incremental resize and possible repetions on the %d different keys.\n",n,nbKeys);
+    int tabValue[nbKeys];
+    for(int i=0;i<nbKeys;i++)
+        tabValue[i]=-1;
+    char key[20];
+    HashTable h = hashtableCreate(1);
+    hashtableSetIncrementalResize(&h,1);
+
+    size_t nbOfPairs =0;
+    int migrations = 0;
+    for(int i=0;i<n;i++){
+        int r = rand()%nbKeys;
+        sprintf(key,"key %d",r);
+        if(rand()%4==0){
+            int removed = hashtableRemove(&h,key);
+            if(removed != (tabValue[r]!=-1)){
+                printf("Failed: hashtableRemove returns %d for key '%s'.\n",removed,key);
+                return 0;
+            }
+            if(removed)
+                nbOfPairs--;
+            tabValue[r]=-1;
+        }
+        else{
+            if(tabValue[r]==-1)
+                nbOfPairs++;
+            tabValue[r] = rand() % 100;
+            hashtableInsert(&h,key,tabValue[r]);
+        }
+        if(h.oldTable!=NULL)
+            migrations++;
+        for(int j=0;j<nbKeys;j++){
+            sprintf(key,"key %d",j);
+            if(hashtableHasKey(h,key)!=(tabValue[j]!=-1)){
+                printf("Failed: hashtableHasKey gives a wrong answer for key '%s' during a migration.\n",key);
+                return 0;
+            }
+            if(tabValue[j]!=-1 && hashtableGetValue(h,key)!=tabValue[j]){
+                printf("Failed: hashtableGetValue gives a wrong value for key '%s' during a migration.\n",key);
+                return 0;
+            }
+        }
+    }
+    if(migrations==0){
+        printf("Failed: the table was never migrating incrementally.\n");
+        return 0;
+    }
+    if(h.numberOfPairs != nbOfPairs){
+        printf("Failed : the number of pairs in the hashtable (%zu) is different from the expected number of pairs (%zu).\n", h.numberOfPairs, nbOfPairs);
+        return 0;
+    }
+
+    hashtableSetIncrementalResize(&h,0);
+    if(h.oldTable!=NULL){
+        printf("Failed: the migration is not completed when the incremental resize is disabled.\n");
+        return 0;
+    }
+    hashtableDestroy(&h);
+    printf("Passed!\n");
+    return 1;
+}
+
+int test_hashtableIncrementalResize_vg(){
+    int score=valgrind_test("hashtableIncrementalResize","","Memory test for the incremental resize");
+    return score;
+}
+
+int test_hashtableIncrementalResize(){
+    printf("----------------------------------------------\n");
+    printf("Unit tests for the incremental resize \n");
+    printf("----------------------------------------------\n");
+
+    int score = test_hashtableIncrementalResize_results();
+    score+=test_hashtableIncrementalResize_vg();
+    return score;
+}
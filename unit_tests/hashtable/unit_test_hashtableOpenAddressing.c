@@ -0,0 +1,81 @@
+int test_hashtableOpenAddressing_results(){
+    int n = 1000+rand()%2000;
+    int nbKeys = 600;
+
+    printf("** Insert and remove %d random pairs (key,value) in an open addressing hashtable of size 1 with possible repetions on the %d different keys.\n",n,nbKeys);
+    int tabValue[nbKeys];
+    for(int i=0;i<nbKeys;i++)
+        tabValue[i]=-1;
+    char key[20];
+    HashTable h = hashtableCreateWithEngine(1,HASHTABLE_OPEN_ADDRESSING);
+    if(h.sizeTable!=8 || h.table!=NULL || h.slots==NULL){
+        printf("Failed: fields (sizeTable,table,slots) should be (8,NULL,not NULL) but are (%zu,%p,%p).\n",
+                h.sizeTable,(void*)h.table,(void*)h.slots);
+        return 0;
+    }
+
+    size_t nbOfPairs =0;
+    for(int i=0;i<n;i++){
+        int r = rand()%nbKeys;
+        sprintf(key,"key %d",r);
+        if(rand()%4==0){
+            int removed = hashtableRemove(&h,key);
+            if(removed != (tabValue[r]!=-1)){
+                printf("Failed: hashtableRemove returns %d for key '%s'.\n",removed,key);
+                return 0;
+            }
+            if(removed)
+                nbOfPairs--;
+            tabValue[r]=-1;
+        }
+        else{
+            if(tabValue[r]==-1)
+                nbOfPairs++;
+            tabValue[r] = rand() % 100;
+            hashtableInsert(&h,key,tabValue[r]);
+        }
+    }
+    if(h.numberOfPairs != nbOfPairs){
+        printf("Failed : the number of pairs in the hashtable (%zu) is different from the expected number of pairs (%zu).\n", h.numberOfPairs, nbOfPairs);
+        return 0;
+    }
+    if(8*h.numberOfPairs > 7*h.sizeTable){
+        printf("Failed : the load factor of the hashtable is too high (%zu pairs for %zu slots).\n", h.numberOfPairs, h.sizeTable);
+        return 0;
+    }
+
+    for(int i=0;i<nbKeys;i++){
+        sprintf(key,"key %d",i);
+        if(hashtableHasKey(h,key)!=(tabValue[i]!=-1)){
+            printf("Failed: hashtableHasKey gives a wrong answer for key '%s'.\n",key);
+            return 0;
+        }
+        if(tabValue[i]!=-1 && hashtableGetValue(h,key)!=tabValue[i]){
+            printf("Failed: hashtableGetValue gives a wrong value for key '%s'.\n",key);
+            return 0;
+        }
+    }
+
+    hashtableDestroy(&h);
+    if(h.sizeTable!=0 || h.numberOfPairs!=0 || h.slots!=NULL){
+        printf("Failed: fields (sizeTable,numberOfPairs,slots) should be (0,0,NULL) after hashtableDestroy.\n");
+        return 0;
+    }
+    printf("Passed!\n");
+    return 1;
+}
+
+int test_hashtableOpenAddressing_vg(){
+    int score=valgrind_test("hashtableOpenAddressing","","Memory test for the open addressing engine");
+    return score;
+}
+
+int test_hashtableOpenAddressing(){
+    printf("----------------------------------------------\n");
+    printf("Unit tests for the open addressing engine \n");
+    printf("----------------------------------------------\n");
+
+    int score = test_hashtableOpenAddressing_results();
+    score+=test_hashtableOpenAddressing_vg();
+    return score;
+}
@@ -17,6 +17,11 @@
 #include "unit_test_hashtableHasKey.c"
 #include "unit_test_hashtableGetValue.c"
 #include "unit_test_hashtableRemove.c"
+#include "unit_test_hashtableOpenAddressing.c"
+#include "unit_test_hashtableIncrementalResize.c"
+#include "unit_test_hashtableGetOrInsert.c"
+#include "unit_test_hashtableArena.c"
+#include "unit_test_hashtableHashFunction.c"
 
 int main(int argc, char* argv[]){
     srand(time(NULL));
@@ -47,6 +52,21 @@ int main(int argc, char* argv[]){
     if(strcmp(argv[1],"hashtableRemove") ==0){
         test_hashtableRemove_results();
     }
+    if(strcmp(argv[1],"hashtableOpenAddressing") ==0){
+        test_hashtableOpenAddressing_results();
+    }
+    if(strcmp(argv[1],"hashtableIncrementalResize") ==0){
+        test_hashtableIncrementalResize_results();
+    }
+    if(strcmp(argv[1],"hashtableGetOrInsert") ==0){
+        test_hashtableGetOrInsert_results();
+    }
+    if(strcmp(argv[1],"hashtableArena") ==0){
+        test_hashtableArena_results();
+    }
+    if(strcmp(argv[1],"hashtableHashFunction") ==0){
+        test_hashtableHashFunction_results();
+    }
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,139 @@
+/**
+ * \file rng.c
+ * \brief Pseudo random number generators with an explicit state.
+ *
+ * Source code of the functions declared in rng.h. The generator is xoshiro256**
+ * of Blackman and Vigna, seeded with splitmix64.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "rng.h"
+
+
+/**
+ * \brief Rotation of a 64 bits integer to the left
+ */
+static inline uint64_t rotateLeft(uint64_t x, int k){
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * \brief Next number of splitmix64, used to fill the state of a generator
+ */
+static uint64_t splitmix64(uint64_t *x){
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+
+/**
+ * \fn void rngSeed(RandomGenerator *generator, uint64_t seed)
+ * \brief Initialize a generator from a seed.
+ * \param generator The generator to initialize.
+ * \param seed The seed.
+ */
+void rngSeed(RandomGenerator *generator, uint64_t seed){
+    for (int i = 0; i < 4; i++){
+        generator->state[i] = splitmix64(&seed);
+    }
+}
+
+
+/**
+ * \fn uint64_t rngNext(RandomGenerator *generator)
+ * \brief Draw a uniform 64 bits integer.
+ * \param generator The generator.
+ * \return The next number of the stream of the generator.
+ */
+uint64_t rngNext(RandomGenerator *generator){
+    uint64_t *s = generator->state;
+    uint64_t result = rotateLeft(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+    return result;
+}
+
+
+/**
+ * \fn uint32_t rngBounded(RandomGenerator *generator, uint32_t bound)
+ * \brief Draw a uniform integer in {0,...,bound-1}.
+ * \param generator The generator.
+ * \param bound The number of possible values, at least 1.
+ * \return The random integer.
+ *
+ * Multiply-shift reduction of Lemire: the high 32 bits of x*bound, where x
+ * is a 32 bits random integer, and the few values of x that would give
+ * a bias are rejected.
+ */
+uint32_t rngBounded(RandomGenerator *generator, uint32_t bound){
+    uint64_t product = (rngNext(generator) >> 32) * (uint64_t) bound;
+    uint32_t low = (uint32_t) product;
+    if (low < bound){
+        uint32_t threshold = -bound % bound;
+        while (low < threshold){
+            product = (rngNext(generator) >> 32) * (uint64_t) bound;
+            low = (uint32_t) product;
+        }
+    }
+    return (uint32_t) (product >> 32);
+}
+
+
+/**
+ * \fn double rngDouble(RandomGenerator *generator)
+ * \brief Draw a uniform real number in [0,1).
+ * \param generator The generator.
+ * \return The random real number, a multiple of 2^-53.
+ */
+double rngDouble(RandomGenerator *generator){
+    return (rngNext(generator) >> 11) * 0x1.0p-53;
+}
+
+
+/**
+ * \fn void rngJump(RandomGenerator *generator)
+ * \brief Move a generator 2^128 numbers forward.
+ * \param generator The generator.
+ */
+void rngJump(RandomGenerator *generator){
+    static const uint64_t jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                     0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++){
+        for (int b = 0; b < 64; b++){
+            if (jump[i] & ((uint64_t) 1 << b)){
+                for (int k = 0; k < 4; k++){
+                    s[k] ^= generator->state[k];
+                }
+            }
+            rngNext(generator);
+        }
+    }
+    for (int k = 0; k < 4; k++){
+        generator->state[k] = s[k];
+    }
+}
+
+
+/**
+ * \fn RandomGenerator* rngDefault(void)
+ * \brief Shared generator used by the functions that take no generator.
+ * \return A pointer on the shared generator.
+ */
+RandomGenerator* rngDefault(void){
+    static RandomGenerator generator;
+    static int seeded = 0;
+    if (!seeded){
+        rngSeed(&generator, 0);
+        seeded = 1;
+    }
+    return &generator;
+}
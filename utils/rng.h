@@ -0,0 +1,84 @@
+/**
+ * \file rng.h
+ * \brief Pseudo random number generators with an explicit state.
+ *
+ * Header file that declares a small pseudo random number generator (xoshiro256**)
+ * whose state is stored in a variable of the caller. Two generators never share
+ * their state, so each thread or each benchmark can use its own reproducible stream,
+ * unlike rand() whose state is global.
+ */
+
+
+#ifndef RNG_H_INCLUDED
+#define RNG_H_INCLUDED
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+/**
+ * \struct RandomGenerator
+ * \brief State of a pseudo random number generator.
+ */
+typedef struct randomGenerator {
+    uint64_t state[4]; /**< State of xoshiro256**, never all zero */
+} RandomGenerator;
+
+
+/**
+ * \fn void rngSeed(RandomGenerator *generator, uint64_t seed)
+ * \brief Initialize a generator from a seed.
+ * \param generator The generator to initialize.
+ * \param seed The seed. Two generators with the same seed give the same numbers.
+ *
+ * The state is filled with splitmix64, so close seeds give unrelated streams.
+ */
+void rngSeed(RandomGenerator *generator, uint64_t seed);
+
+/**
+ * \fn uint64_t rngNext(RandomGenerator *generator)
+ * \brief Draw a uniform 64 bits integer.
+ * \param generator The generator.
+ * \return The next number of the stream of the generator.
+ */
+uint64_t rngNext(RandomGenerator *generator);
+
+/**
+ * \fn uint32_t rngBounded(RandomGenerator *generator, uint32_t bound)
+ * \brief Draw a uniform integer in {0,...,bound-1}.
+ * \param generator The generator.
+ * \param bound The number of possible values, at least 1.
+ * \return The random integer, without the bias of rand()%bound.
+ */
+uint32_t rngBounded(RandomGenerator *generator, uint32_t bound);
+
+/**
+ * \fn double rngDouble(RandomGenerator *generator)
+ * \brief Draw a uniform real number in [0,1).
+ * \param generator The generator.
+ * \return The random real number, a multiple of 2^-53.
+ */
+double rngDouble(RandomGenerator *generator);
+
+/**
+ * \fn void rngJump(RandomGenerator *generator)
+ * \brief Move a generator 2^128 numbers forward.
+ * \param generator The generator.
+ *
+ * To get independent streams (one per thread for instance), seed a generator,
+ * copy it, and jump once more for each new copy: the streams do not overlap.
+ */
+void rngJump(RandomGenerator *generator);
+
+/**
+ * \fn RandomGenerator* rngDefault(void)
+ * \brief Shared generator used by the functions that take no generator.
+ * \return A pointer on the shared generator, seeded with 0 at the start of the program.
+ *
+ * Its state is global, so it must not be used by several threads at the same time.
+ * Call rngSeed(rngDefault(), seed) to change the numbers of all these functions.
+ */
+RandomGenerator* rngDefault(void);
+
+
+#endif // RNG_H_INCLUDED
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include "utils.h"
+#include "rng.h"
 
 
 /**
@@ -47,6 +48,81 @@ void testUtils() {
 
 }
 
+/**
+ * \fn void testRandomGenerator()
+ * \brief Test the functions declared in rng.h and compare their speed with rand()
+ *
+ */
+void testRandomGenerator() {
+    printf("\n---- Test random generators ----\n");
+    RandomGenerator first, second;
+    // Same seed, same numbers
+    rngSeed(&first, 42);
+    rngSeed(&second, 42);
+    int same = 1;
+    for (int i = 0; i < 1000; i++) {
+        if (rngNext(&first) != rngNext(&second))
+            same = 0;
+    }
+    printf("same seed : %s numbers\n", same ? "same" : "DIFFERENT");
+    // A jump gives another stream
+    rngJump(&second);
+    int equal = 0;
+    for (int i = 0; i < 1000; i++) {
+        if (rngNext(&first) == rngNext(&second))
+            equal++;
+    }
+    printf("after a jump : %d equal numbers over 1000\n", equal);
+    // Uniformity of rngBounded and range of rngDouble
+    int bound = 10;
+    long counts[10] = {0};
+    int draws = 1000000;
+    int inRange = 1;
+    for (int i = 0; i < draws; i++) {
+        uint32_t value = rngBounded(&first, bound);
+        if (value >= (uint32_t) bound)
+            inRange = 0;
+        else
+            counts[value]++;
+        double real = rngDouble(&first);
+        if (real < 0 || real >= 1)
+            inRange = 0;
+    }
+    double chi2 = 0;
+    for (int k = 0; k < bound; k++) {
+        double expected = (double) draws / bound;
+        chi2 += (counts[k] - expected) * (counts[k] - expected) / expected;
+    }
+    printf("rngBounded(10) and rngDouble : %s, chi2 = %.2f (9 degrees of freedom)\n",
+           inRange ? "in range" : "OUT OF RANGE", chi2);
+    // The permutations only depend on the state of the generator
+    int permutation1[1000], permutation2[1000];
+    int seen[1000] = {0};
+    rngSeed(&first, 7);
+    rngSeed(&second, 7);
+    uniformRandomPermutationWithGenerator(permutation1, 1000, &first);
+    uniformRandomPermutationWithGenerator(permutation2, 1000, &second);
+    int valid = 1;
+    for (int i = 0; i < 1000; i++) {
+        if (permutation1[i] != permutation2[i] || seen[permutation1[i]]++)
+            valid = 0;
+    }
+    printf("permutations from the same seed : %s\n", valid ? "same valid permutation" : "DIFFERENT");
+    // Speed compared with rand()
+    int n = 10000000;
+    unsigned int sum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < n; i++)
+        sum += rand() % 1000;
+    double timeRand = (double) (clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (int i = 0; i < n; i++)
+        sum += rngBounded(&first, 1000);
+    double timeGenerator = (double) (clock() - start) / CLOCKS_PER_SEC;
+    printf("%d draws in {0,...,999} : rand() %.3f s, rngBounded %.3f s (%u)\n", n, timeRand, timeGenerator, sum % 10);
+    printf("---- Fin test random generators ----\n");
+}
+
 
 
 /**
@@ -57,5 +133,6 @@ void testUtils() {
 int main(void){
         srand(time(NULL));
         testUtils();
+        testRandomGenerator();
         return 0;
 }
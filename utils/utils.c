@@ -41,16 +41,27 @@ int intComparator ( const void * first, const void * second ) {
  * \endparblock
  * \param n The size of the permutation (over {0,...,n-1}).
  *
- * Warning: the function srand must be called before using this function.
+ * The numbers are drawn with the shared generator rngDefault().
  */
 void uniformRandomPermutation(int *permutation, size_t n ){
+    uniformRandomPermutationWithGenerator(permutation, n, rngDefault());
+}
+
+/**
+ * \fn void uniformRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator)
+ * \brief Same as uniformRandomPermutation, with the numbers drawn from a given generator.
+ * \param permutation Array of n integers, already allocated.
+ * \param n The size of the permutation (over {0,...,n-1}).
+ * \param generator The generator.
+ */
+void uniformRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator){
     // Initialize permutation
     for (size_t i = 0; i < n; i++)
         permutation[i]=(int) i;
     // Iterate through the array
-    for (size_t i = 0; i < n - 1; i++) {
+    for (size_t i = 0; i + 1 < n; i++) {
         // Generate a random index between i and n-1
-        size_t j = i + rand() / (RAND_MAX / (n - i) + 1);
+        size_t j = i + rngBounded(generator, (uint32_t) (n - i));
         // Swap the current element with the element at the random index
         int t = permutation[j];
         permutation[j] = permutation[i];
@@ -73,10 +84,21 @@ void uniformRandomPermutation(int *permutation, size_t n ){
  * following way: a uniform random permutation if first generated and
  * then, the first q=n/10 elements are sorted.
  *
- * Warning: the function srand must be called before using this function.
+ * The numbers are drawn with the shared generator rngDefault().
  */
 void biaisedRandomPermutation(int *permutation, size_t n ){
-    uniformRandomPermutation(permutation,n);
+    biaisedRandomPermutationWithGenerator(permutation, n, rngDefault());
+}
+
+/**
+ * \fn void biaisedRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator)
+ * \brief Same as biaisedRandomPermutation, with the numbers drawn from a given generator.
+ * \param permutation Array of n integers, already allocated.
+ * \param n The size of the permutation (over {0,...,n-1}).
+ * \param generator The generator.
+ */
+void biaisedRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator){
+    uniformRandomPermutationWithGenerator(permutation,n,generator);
     int nDiv10 = n/10;
     qsort(permutation,nDiv10,sizeof(int),intComparator);
 }
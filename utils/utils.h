@@ -14,6 +14,7 @@
 #define UTILS_H_INCLUDED
 
 #include <stdlib.h>
+#include "rng.h"
 
 
 
@@ -39,11 +40,20 @@ int intComparator ( const void * first, const void * second );
  * \endparblock
  * \param n The size of the permutation (over {0,...,n-1}).
  *
- * Warning: the function srand must be called before using this function.
+ * The numbers are drawn with the shared generator rngDefault().
  *
  */
 void uniformRandomPermutation(int *permutation, size_t n );
 
+/**
+ * \fn void uniformRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator)
+ * \brief Same as uniformRandomPermutation, with the numbers drawn from a given generator.
+ * \param permutation Array of n integers, already allocated.
+ * \param n The size of the permutation (over {0,...,n-1}).
+ * \param generator The generator, so that the permutation only depends on its state.
+ */
+void uniformRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator);
+
 /**
  * \fn void biaisedRandomPermutation(int *permutation, size_t n )
  * \brief Generate a biaised random permutation of {0,1,..,n-1}.
@@ -59,9 +69,18 @@ void uniformRandomPermutation(int *permutation, size_t n );
  * following way: a uniform random permutation if first generated and
  * then, the first q=n/10 elements are sorted.
  *
- * Warning: the function srand must be called before using this function.
+ * The numbers are drawn with the shared generator rngDefault().
  */
 void biaisedRandomPermutation(int *permutation, size_t n );
 
+/**
+ * \fn void biaisedRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator)
+ * \brief Same as biaisedRandomPermutation, with the numbers drawn from a given generator.
+ * \param permutation Array of n integers, already allocated.
+ * \param n The size of the permutation (over {0,...,n-1}).
+ * \param generator The generator, so that the permutation only depends on its state.
+ */
+void biaisedRandomPermutationWithGenerator(int *permutation, size_t n, RandomGenerator *generator);
+
 
 #endif // UTILS_H_INCLUDED